@@ -261,31 +261,6 @@ constexpr uint64_t subsetFromIndex(uint64_t mask, int index) {
     return result;
 }
 
-constexpr auto generateBishopAttackTable() {
-    std::array<std::array<uint64_t, 512>, 64> table{};
-
-    for (int sq = 0; sq < 64; ++sq) {
-        uint64_t mask = BISHOP_MASKS[sq];
-        int bits = __builtin_popcountll(mask);
-
-        for (int i = 0; i < (1 << bits); ++i) {
-            uint64_t blockers = subsetFromIndex(mask, i);
-            uint64_t attack = bishopAttacksFor(sq, blockers);
-
-            uint64_t index = bishopMagicIndex(blockers, sq);
-            table[sq][index] = attack;
-        }
-    }
-    return table;
-}
-
-constexpr auto BISHOP_ATTACKS = generateBishopAttackTable();
-
-inline uint64_t bishopAttacks(int sq, uint64_t occAll) {
-    uint64_t blockers = occAll & BISHOP_MASKS[sq];
-    return BISHOP_ATTACKS[sq][bishopMagicIndex(blockers, sq)];
-}
-
 /* ============================================================
                            TORRE
    ============================================================ */
@@ -377,29 +352,128 @@ constexpr uint64_t rookMagicIndex(uint64_t blockers, int sq) {
     return (blockers * ROOK_MAGICS[sq]) >> ROOK_SHIFTS[sq];
 }
 
-constexpr auto generateRookAttackTable() {
-    std::array<std::array<uint64_t, 4096>, 64> table{};
+/* ============================================================
+              TABELA COMPARTILHADA (FANCY MAGIC)
+   ============================================================ */
+// Cada casa usa só 2^bits entradas (bits = casas relevantes da máscara), então
+// em vez de 64 fatias de tamanho fixo (512 para bispo, 4096 para torre, quase
+// tudo vazio) as fatias de tamanho variável ficam coladas numa única tabela.
+// Bispos primeiro, torres em seguida: 107648 entradas (~841 KB) no lugar de ~2.3 MB.
 
+/**
+ * @brief Offset de cada casa na tabela compartilhada. A entrada 64 é o fim da última fatia.
+ * O tamanho da fatia vem do shift mágico: 2^(64 - shift) = 2^bits.
+ */
+constexpr auto generateSliderOffsets(const int (&shifts)[64], uint32_t start) {
+    std::array<uint32_t, 65> offsets{};
+    offsets[0] = start;
+    for (int sq = 0; sq < 64; ++sq)
+        offsets[sq + 1] = offsets[sq] + (1u << (64 - shifts[sq]));
+    return offsets;
+}
+
+constexpr auto BISHOP_OFFSETS = generateSliderOffsets(BISHOP_SHIFTS, 0);
+constexpr auto ROOK_OFFSETS = generateSliderOffsets(ROOK_SHIFTS, BISHOP_OFFSETS[64]);
+constexpr uint32_t SLIDER_TABLE_SIZE = ROOK_OFFSETS[64];
+
+/**
+ * @brief Preenche as fatias de uma peça deslizante na tabela compartilhada.
+ * @param indexOf Função que leva (bloqueios, índice do subconjunto, casa) ao índice dentro da fatia
+ */
+template<typename Table, typename AttacksFor, typename IndexOf>
+constexpr void fillSliderTable(Table& table, const uint64_t (&masks)[64], const std::array<uint32_t, 65>& offsets,
+                               AttacksFor attacksFor, IndexOf indexOf) {
     for (int sq = 0; sq < 64; ++sq) {
-        uint64_t mask = ROOK_MASKS[sq];
+        uint64_t mask = masks[sq];
         int bits = __builtin_popcountll(mask);
 
         for (int i = 0; i < (1 << bits); ++i) {
             uint64_t blockers = subsetFromIndex(mask, i);
-            uint64_t attack = rookAttacksFor(sq, blockers);
-
-            uint64_t index = rookMagicIndex(blockers, sq);
-            table[sq][index] = attack;
+            table[offsets[sq] + indexOf(blockers, i, sq)] = attacksFor(sq, blockers);
         }
     }
+}
+
+constexpr auto generateSliderAttackTable() {
+    std::array<uint64_t, SLIDER_TABLE_SIZE> table{};
+
+    fillSliderTable(table, BISHOP_MASKS, BISHOP_OFFSETS, bishopAttacksFor,
+                    [](uint64_t blockers, int, int sq) { return bishopMagicIndex(blockers, sq); });
+    fillSliderTable(table, ROOK_MASKS, ROOK_OFFSETS, rookAttacksFor,
+                    [](uint64_t blockers, int, int sq) { return rookMagicIndex(blockers, sq); });
     return table;
 }
 
-constexpr auto ROOK_ATTACKS = generateRookAttackTable();
+constexpr auto SLIDER_ATTACKS = generateSliderAttackTable();
 
-inline uint64_t rookAttacks(int sq, uint64_t occAll) {
+inline uint64_t bishopAttacksMagic(int sq, uint64_t occAll) {
+    uint64_t blockers = occAll & BISHOP_MASKS[sq];
+    return SLIDER_ATTACKS[BISHOP_OFFSETS[sq] + bishopMagicIndex(blockers, sq)];
+}
+
+inline uint64_t rookAttacksMagic(int sq, uint64_t occAll) {
     uint64_t blockers = occAll & ROOK_MASKS[sq];
-    return ROOK_ATTACKS[sq][rookMagicIndex(blockers, sq)];
+    return SLIDER_ATTACKS[ROOK_OFFSETS[sq] + rookMagicIndex(blockers, sq)];
+}
+
+/* ============================================================
+                    PEXT (BMI2) - OPCIONAL
+   ============================================================ */
+// Compilado com USE_PEXT (make PEXT=1), o índice vem direto de _pext_u64:
+// os bits de ocupação sob a máscara são compactados num inteiro de 0..2^bits-1.
+// Sem multiplicação nem constantes mágicas. O layout é o mesmo da tabela
+// compartilhada (mesmos offsets), só muda a ordem dentro de cada fatia.
+#ifdef USE_PEXT
+
+#ifndef __BMI2__
+#error "USE_PEXT exige uma CPU com BMI2 (compile com -mbmi2 ou -march=native)"
+#endif
+
+#include <immintrin.h>
+
+// subsetFromIndex(mask, i) é exatamente o inverso de pext(., mask),
+// então o índice dentro da fatia é o próprio i
+constexpr auto generatePextAttackTable() {
+    std::array<uint64_t, SLIDER_TABLE_SIZE> table{};
+
+    fillSliderTable(table, BISHOP_MASKS, BISHOP_OFFSETS, bishopAttacksFor,
+                    [](uint64_t, int i, int) { return uint64_t(i); });
+    fillSliderTable(table, ROOK_MASKS, ROOK_OFFSETS, rookAttacksFor,
+                    [](uint64_t, int i, int) { return uint64_t(i); });
+    return table;
+}
+
+constexpr auto PEXT_ATTACKS = generatePextAttackTable();
+
+inline uint64_t bishopAttacksPext(int sq, uint64_t occAll) {
+    return PEXT_ATTACKS[BISHOP_OFFSETS[sq] + _pext_u64(occAll, BISHOP_MASKS[sq])];
+}
+
+inline uint64_t rookAttacksPext(int sq, uint64_t occAll) {
+    return PEXT_ATTACKS[ROOK_OFFSETS[sq] + _pext_u64(occAll, ROOK_MASKS[sq])];
+}
+
+#endif // USE_PEXT
+
+/* ============================================================
+                    API DOS DESLIZANTES
+   ============================================================ */
+// O backend é escolhido na compilação; o resto da engine só usa estas funções.
+
+inline uint64_t bishopAttacks(int sq, uint64_t occAll) {
+#ifdef USE_PEXT
+    return bishopAttacksPext(sq, occAll);
+#else
+    return bishopAttacksMagic(sq, occAll);
+#endif
+}
+
+inline uint64_t rookAttacks(int sq, uint64_t occAll) {
+#ifdef USE_PEXT
+    return rookAttacksPext(sq, occAll);
+#else
+    return rookAttacksMagic(sq, occAll);
+#endif
 }
 
 /* ============================================================
@@ -459,3 +533,38 @@ constexpr auto generateBetweenTable()
 }
 
 constexpr auto BETWEEN = generateBetweenTable();
+
+/* ============================================================
+                          LINE MASK
+   ============================================================ */
+// Linha inteira (de borda a borda) que passa por 'a' e 'b', incluindo as duas casas.
+// Zero se as casas não estão alinhadas em coluna, fileira ou diagonal.
+// Usada para restringir o movimento de peças cravadas ao raio rei-atacante.
+
+constexpr uint64_t lineThrough(int a, int b)
+{
+    if (a == b) return 0;
+
+    uint64_t rookA = rookAttacksFor(a, 0);
+    if (rookA & BB(b))
+        return (rookA & rookAttacksFor(b, 0)) | BB(a) | BB(b);
+
+    uint64_t bishopA = bishopAttacksFor(a, 0);
+    if (bishopA & BB(b))
+        return (bishopA & bishopAttacksFor(b, 0)) | BB(a) | BB(b);
+
+    return 0;
+}
+
+constexpr auto generateLineTable()
+{
+    std::array<std::array<uint64_t,64>,64> t{};
+
+    for (int a = 0; a < 64; ++a)
+        for (int b = 0; b < 64; ++b)
+            t[a][b] = lineThrough(a,b);
+
+    return t;
+}
+
+constexpr auto LINE = generateLineTable();
@@ -3,6 +3,9 @@
 #include "attack.h"
 #include "piece.h"
 #include <iostream>
+#include <array>
+#include <cstring>
+#include <cstdlib>
 
 Board Board::fromFEN(const char* fen) {
     Board b = {};
@@ -18,22 +21,13 @@ Board Board::fromFEN(const char* fen) {
         } else if (isdigit(c)) {
             sq += c - '0';
         } else {
-            uint64_t bit = 1ULL << sq;
-
-            switch (c) {
-                case 'P': b.whitePawns   |= bit; break;
-                case 'N': b.whiteKnights |= bit; break;
-                case 'B': b.whiteBishops |= bit; break;
-                case 'R': b.whiteRooks   |= bit; break;
-                case 'Q': b.whiteQueens  |= bit; break;
-                case 'K': b.whiteKing    |= bit; break;
-
-                case 'p': b.blackPawns   |= bit; break;
-                case 'n': b.blackKnights |= bit; break;
-                case 'b': b.blackBishops |= bit; break;
-                case 'r': b.blackRooks   |= bit; break;
-                case 'q': b.blackQueens  |= bit; break;
-                case 'k': b.blackKing    |= bit; break;
+            // Ordem igual à do enum Piece: WPAWN..WKING, BPAWN..BKING
+            static constexpr char PIECE_CHARS[] = "PNBRQKpnbrqk";
+            for (int i = 0; i < 12; ++i) {
+                if (PIECE_CHARS[i] == c) {
+                    b.putPiece(Piece(WPAWN + i), sq);
+                    break;
+                }
             }
             sq++;
         }
@@ -61,6 +55,11 @@ Board Board::fromFEN(const char* fen) {
         int rank = fen[1] - '1';
         b.enPassantSquare = rank * 8 + file;
     }
+
+    // Halfmove clock (opcional: alguns FENs param no en passant)
+    while (*fen && *fen != ' ') fen++;
+    while (*fen == ' ') fen++;
+    if (isdigit(*fen)) b.halfmoveClock = std::atoi(fen);
         
     b.computeHash();
     
@@ -70,314 +69,348 @@ Board Board::fromFEN(const char* fen) {
 
 Board Board::applyMove(const Move& m) const {
     Board b = *this;
-    
-    // ==========================================================
-    // ETAPA 0: Identificação (Quem está envolvido?)
-    // ==========================================================
-    
-    // Quem está movendo?
-    int pFrom = pieceAt(m.from); 
+    b.attacksValid = false; // Os mapas de ataque não são mantidos aqui
 
-    // Quem foi capturado? (Se for captura)
-    int pCaptured = EMPTY;
-    int captureSq = m.to;
- 
-    if (m.flags & CAPTURE) {
-        if (m.flags & EN_PASSANT) {
-            captureSq = whiteToMove ? (m.to - 8) : (m.to + 8);
-            pCaptured = whiteToMove ? BPAWN : WPAWN;
-        } else { 
-            pCaptured = this->pieceAt(m.to);
-        }
-    }
+    StateInfo st;
+    b.makeMove(m, st);
+    return b;
+}
 
-    // =======================================================
-    // Atualização de Hash das PEÇAS (Tira Velha -> Põe Nova)
-    // =======================================================
+// Máscara de direitos de roque preservados quando um lance toca a casa.
+// castlingRights: 1=WK, 2=WQ, 4=BK, 8=BQ
+static constexpr auto CASTLING_MASK = [] {
+    std::array<uint8_t, 64> mask{};
+    mask.fill(15);
+    mask[0]  = 15 & ~2;  // a1 (Torre WQ)
+    mask[4]  = 15 & ~3;  // e1 (Rei W)
+    mask[7]  = 15 & ~1;  // h1 (Torre WK)
+    mask[56] = 15 & ~8;  // a8 (Torre BQ)
+    mask[60] = 15 & ~12; // e8 (Rei B)
+    mask[63] = 15 & ~4;  // h8 (Torre BK)
+    return mask;
+}();
+
+#ifdef DEBUG
+// Aborta na primeira divergência, apontando o lance que a causou
+static void checkConsistency(const Board& b, const char* where, const Move& m) {
+    if (b.isConsistent()) return;
+    std::cerr << "[Board] Tabuleiro inconsistente depois de " << where
+              << " (" << int(m.from) << " -> " << int(m.to) << ", flags " << int(m.flags()) << ")\n";
+    std::abort();
+}
+#endif
+
+void Board::makeMove(const Move& m, StateInfo& st) {
+    // Salva o que não pode ser reconstruído a partir do lance
+    st.hashKey = hashKey;
+    st.attacksValid = attacksValid;
+    if (attacksValid) {
+        std::memcpy(st.attackedBy, attackedBy, sizeof(attackedBy));
+    }
+    st.castlingRights = castlingRights;
+    st.enPassantSquare = enPassantSquare;
+    st.halfmoveClock = halfmoveClock;
+    st.pliesFromNull = pliesFromNull;
 
-    // Remove a peça que está saindo da origem
-    b.hashKey ^= Zobrist::pieces[pFrom][m.from];
+    Piece moved = pieceAt(m.from);
+    Piece captured = EMPTY;
+    int captureSq = m.to;
 
-    // Remove a peça capturada (se houver)
-    if (pCaptured != EMPTY) {
-        b.hashKey ^= Zobrist::pieces[pCaptured][captureSq];
+    if (m.flags() & EN_PASSANT) {
+        captureSq = whiteToMove ? (m.to - 8) : (m.to + 8);
+        captured = whiteToMove ? BPAWN : WPAWN;
+    } else if (m.flags() & CAPTURE) {
+        captured = pieceAt(m.to);
     }
+    st.captured = captured;
+
+    // Captura ou lance de peão zeram a regra dos 50 lances
+    halfmoveClock = (typeOf(moved) == PAWN || captured != EMPTY) ? 0 : halfmoveClock + 1;
+    ++pliesFromNull;
 
-    // Adiciona a peça no destino
-    int pTo = pFrom; 
-    if (m.flags & PROMOTION) {
-        pTo = m.promotion;
+    // Remove a peça capturada
+    if (captured != EMPTY) {
+        removePiece(captured, captureSq);
+        hashKey ^= Zobrist::pieces[captured][captureSq];
     }
-    b.hashKey ^= Zobrist::pieces[pTo][m.to];
 
-    // Bitboards de origem e destino
-    uint64_t fromBB = 1ULL << m.from;
-    uint64_t toBB   = 1ULL << m.to;
+    // Tira a peça da origem e coloca no destino (já promovida, se for o caso)
+    Piece placed = (m.flags() & PROMOTION) ? m.promotion() : moved;
 
-    // 1. Limpa o destino (Capturas)
-    // Remove qualquer peça inimiga que esteja na casa de destino
-    if (whiteToMove) {
-        b.blackPawns   &= ~toBB; b.blackKnights &= ~toBB; b.blackBishops &= ~toBB;
-        b.blackRooks   &= ~toBB; b.blackQueens  &= ~toBB; b.blackKing    &= ~toBB;
+    if (placed == moved) {
+        movePiece(moved, m.from, m.to);
     } else {
-        b.whitePawns   &= ~toBB; b.whiteKnights &= ~toBB; b.whiteBishops &= ~toBB;
-        b.whiteRooks   &= ~toBB; b.whiteQueens  &= ~toBB; b.whiteKing    &= ~toBB;
+        removePiece(moved, m.from);
+        putPiece(placed, m.to);
     }
+    hashKey ^= Zobrist::pieces[moved][m.from];
+    hashKey ^= Zobrist::pieces[placed][m.to];
+
+    // Casas cuja ocupação mudou (usadas para a atualização incremental dos ataques)
+    uint64_t changed = BB(m.from) | BB(m.to) | BB(captureSq);
+
+    // Roque: move a torre correspondente
+    if (m.flags() & (KING_CASTLE | QUEEN_CASTLE)) {
+        Piece rook = whiteToMove ? WROOK : BROOK;
+        int rookFrom = (m.flags() & KING_CASTLE) ? m.to + 1 : m.to - 2;
+        int rookTo   = (m.flags() & KING_CASTLE) ? m.to - 1 : m.to + 1;
+
+        movePiece(rook, rookFrom, rookTo);
+        hashKey ^= Zobrist::pieces[rook][rookFrom];
+        hashKey ^= Zobrist::pieces[rook][rookTo];
+        changed |= BB(rookFrom) | BB(rookTo);
+    }
+
+    // Mapas de ataque
+    if (attacksValid && !lazyAttacks) {
+        // Tipos que ganharam ou perderam peças precisam ser recalculados
+        uint8_t dirty[2] = {0, 0};
+        Side us = whiteToMove ? SIDE_WHITE : SIDE_BLACK;
 
-    // 2. Move a peça (Tratando Promoção)
-    if (m.flags & PROMOTION) {
-        // Se for promoção, remove o peão da origem e coloca a NOVA peça no destino
-        if (whiteToMove) {
-            b.whitePawns &= ~fromBB; // Remove peão
-            switch (m.promotion) {
-                case WQUEEN:  b.whiteQueens  |= toBB; break;
-                case WROOK:   b.whiteRooks   |= toBB; break;
-                case WBISHOP: b.whiteBishops |= toBB; break;
-                case WKNIGHT: b.whiteKnights |= toBB; break;
+        dirty[us] |= (1 << typeOf(moved)) | (1 << typeOf(placed));
+        if (m.flags() & (KING_CASTLE | QUEEN_CASTLE)) dirty[us] |= (1 << ROOK);
+        if (captured != EMPTY) dirty[sideOf(captured)] |= (1 << typeOf(captured));
+
+        // Deslizantes cujos raios passavam por alguma casa alterada
+        for (int c = SIDE_WHITE; c <= SIDE_BLACK; ++c) {
+            for (int t = BISHOP; t <= QUEEN; ++t) {
+                if (attackedBy[c][t] & changed) dirty[c] |= (1 << t);
             }
-        } else {
-            b.blackPawns &= ~fromBB; // Remove peão
-            switch (m.promotion) {
-                case BQUEEN:  b.blackQueens  |= toBB; break;
-                case BROOK:   b.blackRooks   |= toBB; break;
-                case BBISHOP: b.blackBishops |= toBB; break;
-                case BKNIGHT: b.blackKnights |= toBB; break;
+        }
+
+        uint64_t occ = allPieces();
+        for (int c = SIDE_WHITE; c <= SIDE_BLACK; ++c) {
+            for (uint8_t d = dirty[c]; d; d &= d - 1) {
+                int t = __builtin_ctz(d);
+                attackedBy[c][t] = pieceAttacks(Side(c), PieceType(t), occ);
             }
         }
     } else {
-        // Movimento Normal (não promoção)
-        // Helper lambda para mover o bit no bitboard correto
-        auto moveBit = [&](uint64_t& bb) {
-            if (bb & fromBB) {
-                bb &= ~fromBB;
-                bb |= toBB;
-            }
-        };
+        attacksValid = false;
+    }
 
-        if (whiteToMove) {
-            moveBit(b.whitePawns); moveBit(b.whiteKnights); moveBit(b.whiteBishops);
-            moveBit(b.whiteRooks); moveBit(b.whiteQueens);  moveBit(b.whiteKing);
-        } else {
-            moveBit(b.blackPawns); moveBit(b.blackKnights); moveBit(b.blackBishops);
-            moveBit(b.blackRooks); moveBit(b.blackQueens);  moveBit(b.blackKing);
-        }
+    // Estado do jogo (remove o antigo do hash, aplica o novo)
+    if (enPassantSquare != -1) {
+        hashKey ^= Zobrist::enPassant[enPassantSquare % 8];
     }
+    hashKey ^= Zobrist::castling[castlingRights];
 
-    // 3. Tratamentos Especiais (Roque e En Passant)
-    
-    // En Passant (A captura não ocorre em 'to', mas na casa do peão inimigo)
-    if (m.flags & EN_PASSANT) {
-        uint64_t captureBB = 1ULL << captureSq;
-        
-        if (whiteToMove) b.blackPawns &= ~captureBB;
-        else             b.whitePawns &= ~captureBB;
+    enPassantSquare = -1;
+    if (m.flags() & DOUBLE_PAWN_PUSH) {
+        enPassantSquare = whiteToMove ? (m.from + 8) : (m.from - 8);
+        hashKey ^= Zobrist::enPassant[enPassantSquare % 8];
     }
 
-    // Roque (Mover a torre correspondente)
-    if (m.flags & KING_CASTLE) {
-        if (whiteToMove) { // h1 -> f1
-            b.whiteRooks &= ~(1ULL << 7); b.whiteRooks |= (1ULL << 5);
-            b.hashKey ^= Zobrist::pieces[WROOK][7];
-            b.hashKey ^= Zobrist::pieces[WROOK][5];
-        } else {           // h8 -> f8
-            b.hashKey ^= Zobrist::pieces[BROOK][63];
-            b.hashKey ^= Zobrist::pieces[BROOK][61];
-            b.blackRooks &= ~(1ULL << 63); b.blackRooks |= (1ULL << 61);
-        }
+    castlingRights &= CASTLING_MASK[m.from] & CASTLING_MASK[m.to];
+    hashKey ^= Zobrist::castling[castlingRights];
+
+    whiteToMove = !whiteToMove;
+    hashKey ^= Zobrist::sideToMove;
+
+#ifdef DEBUG
+    checkConsistency(*this, "makeMove", m);
+#endif
+}
+
+void Board::unmakeMove(const Move& m, const StateInfo& st) {
+    whiteToMove = !whiteToMove;
+
+    // Peça que está no destino (pode ser a peça promovida)
+    Piece placed = pieceAt(m.to);
+    Piece moved = (m.flags() & PROMOTION) ? (whiteToMove ? WPAWN : BPAWN) : placed;
+
+    if (placed == moved) {
+        movePiece(moved, m.to, m.from);
+    } else {
+        removePiece(placed, m.to);
+        putPiece(moved, m.from);
     }
-    if (m.flags & QUEEN_CASTLE) {
-        if (whiteToMove) { // a1 -> d1
-            b.whiteRooks &= ~(1ULL << 0); b.whiteRooks |= (1ULL << 3);
-            b.hashKey ^= Zobrist::pieces[WROOK][0];
-            b.hashKey ^= Zobrist::pieces[WROOK][3];
-        } else {           // a8 -> d8
-            b.hashKey ^= Zobrist::pieces[BROOK][56];
-            b.hashKey ^= Zobrist::pieces[BROOK][59];
-            b.blackRooks &= ~(1ULL << 56); b.blackRooks |= (1ULL << 59);
+
+    if (st.captured != EMPTY) {
+        int captureSq = m.to;
+        if (m.flags() & EN_PASSANT) {
+            captureSq = whiteToMove ? (m.to - 8) : (m.to + 8);
         }
+        putPiece(st.captured, captureSq);
     }
 
-    // 4. Atualizar Estado do Jogo
-
-    // Atualizar hash dos estados (remoção)
-    if (b.enPassantSquare != -1) {
-        b.hashKey ^= Zobrist::enPassant[b.enPassantSquare % 8];
+    // Roque: devolve a torre
+    if (m.flags() & (KING_CASTLE | QUEEN_CASTLE)) {
+        int rookFrom = (m.flags() & KING_CASTLE) ? m.to + 1 : m.to - 2;
+        int rookTo   = (m.flags() & KING_CASTLE) ? m.to - 1 : m.to + 1;
+        movePiece(whiteToMove ? WROOK : BROOK, rookTo, rookFrom);
     }
 
-    b.hashKey ^= Zobrist::castling[b.castlingRights];
-    
-    // Atualiza En Passant Square
-    b.enPassantSquare = -1; // Reset padrão
-    if (m.flags & DOUBLE_PAWN_PUSH) {
-        // A casa de en passant é a casa que foi "pulada"
-        b.enPassantSquare = whiteToMove ? (m.from + 8) : (m.from - 8);
+    hashKey = st.hashKey;
+    attacksValid = st.attacksValid;
+    if (attacksValid) {
+        std::memcpy(attackedBy, st.attackedBy, sizeof(attackedBy));
     }
+    castlingRights = st.castlingRights;
+    enPassantSquare = st.enPassantSquare;
+    halfmoveClock = st.halfmoveClock;
+    pliesFromNull = st.pliesFromNull;
+
+#ifdef DEBUG
+    checkConsistency(*this, "unmakeMove", m);
+#endif
+}
 
-    // Atualiza Direitos de Roque (Castling Rights)
-    // Se rei ou torre moverem, ou torre for capturada, perde o direito.
-    // Máscara simples: Se mexeu em a1, perde WQ; e1, perde ambos W; h1, perde WK...
-    // castlingRights: 1=WK, 2=WQ, 4=BK, 8=BQ
-    
-    auto updateCastling = [&](int sq) {
-        if (sq == 0)  b.castlingRights &= ~2; // a1 (Torre WQ)
-        if (sq == 4)  b.castlingRights &= ~3; // e1 (Rei W)
-        if (sq == 7)  b.castlingRights &= ~1; // h1 (Torre WK)
-        if (sq == 56) b.castlingRights &= ~8; // a8 (Torre BQ)
-        if (sq == 60) b.castlingRights &= ~12;// e8 (Rei B)
-        if (sq == 63) b.castlingRights &= ~4; // h8 (Torre BK)
-    };
-    
-    updateCastling(m.from);
-    updateCastling(m.to);
-    
-    // Atualizar hash dos estados (adição)
-    if (b.enPassantSquare != -1) {
-        b.hashKey ^= Zobrist::enPassant[b.enPassantSquare % 8];
+void Board::makeNullMove(StateInfo& st) {
+    st.hashKey = hashKey;
+    st.enPassantSquare = enPassantSquare;
+    st.halfmoveClock = halfmoveClock;
+    st.pliesFromNull = pliesFromNull;
+
+    // O relógio dos 50 lances continua correndo: passar a vez não é lance irreversível
+    ++halfmoveClock;
+    pliesFromNull = 0;
+
+    if (enPassantSquare != -1) {
+        hashKey ^= Zobrist::enPassant[enPassantSquare % 8];
+        enPassantSquare = -1;
     }
-    b.hashKey ^= Zobrist::castling[b.castlingRights];
 
-    // Inverte o turno
-    b.whiteToMove = !whiteToMove;
-    b.hashKey ^= Zobrist::sideToMove;
-    
-    return b;
+    whiteToMove = !whiteToMove;
+    hashKey ^= Zobrist::sideToMove;
+
+#ifdef DEBUG
+    checkConsistency(*this, "makeNullMove", Move{});
+#endif
 }
 
-void Board::updateAttackBoards() {
-    whiteAttacks = 0;
-    blackAttacks = 0;
+void Board::unmakeNullMove(const StateInfo& st) {
+    whiteToMove = !whiteToMove;
+    hashKey = st.hashKey;
+    enPassantSquare = st.enPassantSquare;
+    halfmoveClock = st.halfmoveClock;
+    pliesFromNull = st.pliesFromNull;
+
+#ifdef DEBUG
+    checkConsistency(*this, "unmakeNullMove", Move{});
+#endif
+}
 
+void Board::updateAttackBoards() const {
     // Occupancy total é necessária para calcular bloqueios de peças deslizantes
     uint64_t occ = allPieces();
-        
-    // ==================== Peões ===============================
-    // Peões brancos atacam casas diagonais à frente
-    // Para ataque a esquerda ir para o rank acima (8 casas) e subtrair uma, um shift de 7 em bitboard
-    // Ataque a direita são 9 casas a mais. Preto é o contrário. 
-
-    // --- Peões Brancos ---
-    whiteAttacks |= ((whitePawns & ~FILE_A) << 7);
-    whiteAttacks |= ((whitePawns & ~FILE_H) << 9);
-    
 
-    // --- Peões Pretos ---
-    blackAttacks |= ((blackPawns & ~FILE_A) >> 9);
-    blackAttacks |= ((blackPawns & ~FILE_H) >> 7);
-    
-    // =================== Cavalos ===============================
-    // Os cavalos pulam em L. Usamos a tabela pré-calculada KNIGHT_ATTACKS.
-    // Iteramos apenas sobre os bits ativos (onde realmente tem cavalo) para performance.
-    
-    // Cavalos Brancos
-    uint64_t wKnights = whiteKnights;
-    while (wKnights) {
-        int sq = __builtin_ctzll(wKnights); // Pega o índice do primeiro bit ativo
-        whiteAttacks |= KNIGHT_ATTACKS[sq];
-        wKnights &= wKnights - 1;           // Remove esse bit para processar o próximo
+    for (int c = SIDE_WHITE; c <= SIDE_BLACK; ++c) {
+        for (int t = PAWN; t <= KING; ++t) {
+            attackedBy[c][t] = pieceAttacks(Side(c), PieceType(t), occ);
+        }
     }
+    attacksValid = true;
+}
 
-    // Cavalos Pretos
-    uint64_t bKnights = blackKnights;
-    while (bKnights) {
-        int sq = __builtin_ctzll(bKnights);
-        blackAttacks |= KNIGHT_ATTACKS[sq];
-        bKnights &= bKnights - 1;
-    }
+uint64_t Board::pieceAttacks(Side c, PieceType t, uint64_t occ) const {
+    uint64_t bb = pieceBB(makePiece(c, t));
+    uint64_t attacks = 0;
+
+    switch (t) {
+        // ==================== Peões ===============================
+        // Peões brancos atacam casas diagonais à frente
+        // Para ataque a esquerda ir para o rank acima (8 casas) e subtrair uma, um shift de 7 em bitboard
+        // Ataque a direita são 9 casas a mais. Preto é o contrário. 
+        case PAWN:
+            if (c == SIDE_WHITE) {
+                attacks |= ((bb & ~FILE_A) << 7);
+                attacks |= ((bb & ~FILE_H) << 9);
+            } else {
+                attacks |= ((bb & ~FILE_A) >> 9);
+                attacks |= ((bb & ~FILE_H) >> 7);
+            }
+            break;
+
+        // =================== Cavalos ===============================
+        // Os cavalos pulam em L. Usamos a tabela pré-calculada KNIGHT_ATTACKS.
+        // Iteramos apenas sobre os bits ativos (onde realmente tem cavalo) para performance.
+        case KNIGHT:
+            while (bb) {
+                attacks |= KNIGHT_ATTACKS[__builtin_ctzll(bb)];
+                bb &= bb - 1;
+            }
+            break;
+
+        // =================== Deslizantes ===========================
+        // Usamos Magic Bitboards para calcular os ataques em O(1) considerando as peças que bloqueiam (occ).
+        case BISHOP:
+            while (bb) {
+                attacks |= bishopAttacks(__builtin_ctzll(bb), occ);
+                bb &= bb - 1;
+            }
+            break;
 
-    // =================== Bispos ================================
-    // Usamos Magic Bitboards para calcular os ataques em O(1) considerando as peças que bloqueiam (occ).
-    
-    // Bispos Brancos
-    uint64_t wBishops = whiteBishops;
-    while (wBishops) {
-        int sq = __builtin_ctzll(wBishops);
-        whiteAttacks |= bishopAttacks(sq, occ);
-        wBishops &= wBishops - 1;
-    }
+        case ROOK:
+            while (bb) {
+                attacks |= rookAttacks(__builtin_ctzll(bb), occ);
+                bb &= bb - 1;
+            }
+            break;
 
-    // Bispos Pretos
-    uint64_t bBishops = blackBishops;
-    while (bBishops) {
-        int sq = __builtin_ctzll(bBishops);
-        blackAttacks |= bishopAttacks(sq, occ);
-        bBishops &= bBishops - 1;
-    }
+        // A rainha combina os movimentos de Torre e Bispo.
+        case QUEEN:
+            while (bb) {
+                attacks |= queenAttacks(__builtin_ctzll(bb), occ);
+                bb &= bb - 1;
+            }
+            break;
 
-    // =================== Torres ================================
-    // Mesma lógica de Magic Bitboards.
-    
-    // Torres Brancas
-    uint64_t wRooks = whiteRooks;
-    while (wRooks) {
-        int sq = __builtin_ctzll(wRooks);
-        whiteAttacks |= rookAttacks(sq, occ);
-        wRooks &= wRooks - 1;
+        // =================== Reis ==================================
+        // O rei se move uma casa em qualquer direção. Usamos tabela pré-calculada.
+        case KING:
+            if (bb) attacks |= KING_ATTACKS[__builtin_ctzll(bb)];
+            break;
     }
 
-    // Torres Pretas
-    uint64_t bRooks = blackRooks;
-    while (bRooks) {
-        int sq = __builtin_ctzll(bRooks);
-        blackAttacks |= rookAttacks(sq, occ);
-        bRooks &= bRooks - 1;
-    }
+    return attacks;
+}
 
-    // =================== Rainhas ===============================
-    // A rainha combina os movimentos de Torre e Bispo.
-    // Basta unir (OR) os ataques de ambos a partir da mesma casa.
-    
-    // Rainhas Brancas
-    uint64_t wQueens = whiteQueens;
-    while (wQueens) {
-        int sq = __builtin_ctzll(wQueens);
-        whiteAttacks |= (bishopAttacks(sq, occ) | rookAttacks(sq, occ));
-        wQueens &= wQueens - 1;
+uint64_t Board::attackedSquares(bool byWhite, uint64_t occ) const {
+    Side c = byWhite ? SIDE_WHITE : SIDE_BLACK;
+    uint64_t attacks = 0;
+    for (int t = PAWN; t <= KING; ++t) {
+        attacks |= pieceAttacks(c, PieceType(t), occ);
     }
+    return attacks;
+}
 
-    // Rainhas Pretas
-    uint64_t bQueens = blackQueens;
-    while (bQueens) {
-        int sq = __builtin_ctzll(bQueens);
-        blackAttacks |= (bishopAttacks(sq, occ) | rookAttacks(sq, occ));
-        bQueens &= bQueens - 1;
-    }
+bool Board::inCheck() const {
+    uint64_t king = pieces[whiteToMove ? SIDE_WHITE : SIDE_BLACK][KING];
+    if (!king) return false;
 
-    // =================== Reis ==================================
-    // O rei se move uma casa em qualquer direção. Usamos tabela pré-calculada.
-    // Como só existe 1 rei (geralmente), verificamos se o bitboard não é zero.
-    
-    if (whiteKing) {
-        whiteAttacks |= KING_ATTACKS[__builtin_ctzll(whiteKing)];
+    if (attacksValid) {
+        return king & attacks(whiteToMove ? SIDE_BLACK : SIDE_WHITE);
     }
 
-    if (blackKing) {
-        blackAttacks |= KING_ATTACKS[__builtin_ctzll(blackKing)];
-    }
+    uint64_t enemies = whiteToMove ? blackPieces() : whitePieces();
+    return attackersTo(__builtin_ctzll(king), allPieces()) & enemies;
 }
 
-uint64_t Board::attackersTo(int sq, uint64_t occupied) const {
+uint64_t Board::attackersTo(int sq, uint64_t occ) const {
     uint64_t attackers = 0;
 
     // Peões
     // Quem ataca 'sq' como peão branco? As casas de onde um peão PRETO atacaria.
     // Usamos sua tabela já existente PAWN_ATTACKS:
     // PAWN_ATTACKS[1] são ataques de peões pretos. A intersecção disso com peões brancos = peões brancos atacando sq.
-    attackers |= (PAWN_ATTACKS[1][sq] & whitePawns);
-    attackers |= (PAWN_ATTACKS[0][sq] & blackPawns);
+    attackers |= (PAWN_ATTACKS[1][sq] & pieces[SIDE_WHITE][PAWN]);
+    attackers |= (PAWN_ATTACKS[0][sq] & pieces[SIDE_BLACK][PAWN]);
 
     // Cavalos
-    attackers |= (KNIGHT_ATTACKS[sq] & (whiteKnights | blackKnights));
+    attackers |= (KNIGHT_ATTACKS[sq] & piecesByType(KNIGHT));
 
     // Bispos e Rainhas (Diagonal)
-    uint64_t diagAttacks = bishopAttacks(sq, occupied);
-    attackers |= (diagAttacks & (whiteBishops | blackBishops | whiteQueens | blackQueens));
+    uint64_t queens = piecesByType(QUEEN);
+    uint64_t diagAttacks = bishopAttacks(sq, occ);
+    attackers |= (diagAttacks & (piecesByType(BISHOP) | queens));
 
     // Torres e Rainhas (Ortogonal)
-    uint64_t orthoAttacks = rookAttacks(sq, occupied);
-    attackers |= (orthoAttacks & (whiteRooks | blackRooks | whiteQueens | blackQueens));
+    uint64_t orthoAttacks = rookAttacks(sq, occ);
+    attackers |= (orthoAttacks & (piecesByType(ROOK) | queens));
 
     // Reis
-    attackers |= (KING_ATTACKS[sq] & (whiteKing | blackKing));
+    attackers |= (KING_ATTACKS[sq] & piecesByType(KING));
 
     return attackers;
 }
@@ -385,43 +418,13 @@ uint64_t Board::attackersTo(int sq, uint64_t occupied) const {
 void Board::computeHash() {
     hashKey = 0;
 
-    uint64_t bb;
-    
-    bb = whitePawns;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[WPAWN][sq]; bb &= bb - 1; }
-    
-    bb = whiteKnights;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[WKNIGHT][sq]; bb &= bb - 1; }
-    
-    bb = whiteBishops;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[WBISHOP][sq]; bb &= bb - 1; }
-    
-    bb = whiteRooks;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[WROOK][sq]; bb &= bb - 1; }
-    
-    bb = whiteQueens;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[WQUEEN][sq]; bb &= bb - 1; }
-    
-    bb = whiteKing;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[WKING][sq]; bb &= bb - 1; }
-
-    bb = blackPawns;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[BPAWN][sq]; bb &= bb - 1; }
-    
-    bb = blackKnights;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[BKNIGHT][sq]; bb &= bb - 1; }
-    
-    bb = blackBishops;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[BBISHOP][sq]; bb &= bb - 1; }
-    
-    bb = blackRooks;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[BROOK][sq]; bb &= bb - 1; }
-    
-    bb = blackQueens;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[BQUEEN][sq]; bb &= bb - 1; }
-    
-    bb = blackKing;
-    while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[BKING][sq]; bb &= bb - 1; }
+    for (int c = SIDE_WHITE; c <= SIDE_BLACK; ++c) {
+        for (int t = PAWN; t <= KING; ++t) {
+            Piece p = makePiece(Side(c), PieceType(t));
+            uint64_t bb = pieces[c][t];
+            while (bb) { int sq = __builtin_ctzll(bb); hashKey ^= Zobrist::pieces[p][sq]; bb &= bb - 1; }
+        }
+    }
 
     hashKey ^= Zobrist::castling[castlingRights];
 
@@ -434,3 +437,32 @@ void Board::computeHash() {
         hashKey ^= Zobrist::sideToMove;
     }   
 }
+
+bool Board::isConsistent() const {
+    uint64_t colors[2] = {0, 0};
+
+    for (int c = SIDE_WHITE; c <= SIDE_BLACK; ++c) {
+        for (int t = PAWN; t <= KING; ++t) {
+            // Um tipo não pode dividir casas com outro
+            if (colors[c] & pieces[c][t]) return false;
+            colors[c] |= pieces[c][t];
+        }
+    }
+
+    if (colors[SIDE_WHITE] & colors[SIDE_BLACK]) return false;
+    if (colors[SIDE_WHITE] != byColor[SIDE_WHITE] || colors[SIDE_BLACK] != byColor[SIDE_BLACK]) return false;
+    if ((colors[SIDE_WHITE] | colors[SIDE_BLACK]) != occupied) return false;
+
+    for (int sq = 0; sq < 64; ++sq) {
+        Piece p = board[sq];
+        if (p == EMPTY) {
+            if (occupied & BB(sq)) return false;
+        } else if (p > BKING || !(pieces[sideOf(p)][typeOf(p)] & BB(sq))) {
+            return false;
+        }
+    }
+
+    Board copy = *this;
+    copy.computeHash();
+    return copy.hashKey == hashKey;
+}
@@ -5,32 +5,52 @@
 #include "bitboard.h"
 #include "../zobrist/zobrist.h"
 
+/**
+ * @brief Informação necessária para desfazer um lance aplicado com Board::makeMove.
+ * Cada ply da busca guarda a sua própria StateInfo (pilha de undo), assim
+ * o tabuleiro é alterado in-place em vez de copiado a cada nó.
+ */
+struct StateInfo {
+    uint64_t hashKey;         // Hash antes do lance
+    uint64_t attackedBy[2][6];// Mapas de ataque antes do lance (só se attacksValid)
+    bool attacksValid;
+    uint8_t castlingRights;   // Direitos de roque antes do lance
+    int8_t enPassantSquare;   // Casa de en passant antes do lance
+    int halfmoveClock;        // Relógio da regra dos 50 lances antes do lance
+    int pliesFromNull;        // Plies desde o último lance nulo antes do lance
+    Piece captured;           // Peça capturada (EMPTY se não houve captura)
+};
+
 struct Board {
 
     // ===== Bitboards =====
-    uint64_t whitePawns;
-    uint64_t whiteKnights;
-    uint64_t whiteBishops;
-    uint64_t whiteRooks;
-    uint64_t whiteQueens;
-    uint64_t whiteKing;
-
-    uint64_t blackPawns;
-    uint64_t blackKnights;
-    uint64_t blackBishops;
-    uint64_t blackRooks;
-    uint64_t blackQueens;
-    uint64_t blackKing;
+    // Uma bitboard por cor e tipo de peça, indexada por [Side][PieceType].
+    // byColor, occupied e o mailbox são caches mantidos por putPiece/removePiece/movePiece,
+    // então nunca escreva em 'pieces' diretamente.
+    uint64_t pieces[2][6];
+    uint64_t byColor[2];
+    uint64_t occupied;
+
+    // ===== Mailbox =====
+    // Peça em cada casa (EMPTY se vazia), espelho das bitboards para o pieceAt em O(1)
+    Piece board[64];
 
     // ===== Estado =====
     bool whiteToMove;
     uint8_t castlingRights;   // bits: 0001 WK, 0010 WQ, 0100 BK, 1000 BQ
     int8_t enPassantSquare;   // -1 se não houver
+    int halfmoveClock = 0;    // Meios-lances desde a última captura ou lance de peão (regra dos 50 lances)
+    int pliesFromNull = 0;    // Meios-lances desde o último lance nulo (ou desde o FEN): limita a busca por repetições
     uint64_t hashKey = 0;     // Hash da posição (Zobrist)
     
-    // Mapa de ataque, casas controladas por cada peça
-    int64_t whiteAttacks;
-    uint64_t blackAttacks;
+    // Mapas de ataque, casas controladas por cada cor e tipo de peça [Side][PieceType].
+    // São um cache: no modo normal makeMove os atualiza incrementalmente, no modo
+    // lazy eles só são calculados quando alguém pede (attacks(), attacksBy()).
+    mutable uint64_t attackedBy[2][6];
+    mutable bool attacksValid = false;
+
+    // Modo lazy: makeMove não mantém os mapas de ataque, apenas os invalida
+    bool lazyAttacks = false;
 
     /**
      * @brief 
@@ -38,7 +58,7 @@ struct Board {
      * @return 
      */
     inline uint64_t whitePieces() const {
-        return whitePawns | whiteKnights | whiteBishops | whiteRooks | whiteQueens | whiteKing;
+        return byColor[SIDE_WHITE];
     }
 
     /**
@@ -47,7 +67,7 @@ struct Board {
      * @return Bit board
      */
     inline uint64_t blackPieces() const {
-        return blackPawns | blackKnights | blackBishops | blackRooks | blackQueens | blackKing;
+        return byColor[SIDE_BLACK];
     }
 
     /**
@@ -56,7 +76,14 @@ struct Board {
      * @return Bit board
      */
     inline uint64_t allPieces() const {
-        return whitePieces() | blackPieces();
+        return occupied;
+    }
+
+    /**
+     * @brief Peças de um tipo, das duas cores
+     */
+    inline uint64_t piecesByType(PieceType t) const {
+        return pieces[SIDE_WHITE][t] | pieces[SIDE_BLACK][t];
     }
 
     /**
@@ -66,33 +93,91 @@ struct Board {
      * @return Enum referente a peça ou vazio 
      */
     inline Piece pieceAt(int sq) const {
+        return board[sq];
+    }
+
+    // ===== Alteração das peças (mantêm byColor, occupied e o mailbox) =====
+    inline void putPiece(Piece p, int sq) {
         uint64_t b = BB(sq);
+        pieces[sideOf(p)][typeOf(p)] |= b;
+        byColor[sideOf(p)] |= b;
+        occupied |= b;
+        board[sq] = p;
+    }
 
-        if (whitePawns & b)   return WPAWN;
-        if (whiteKnights & b) return WKNIGHT;
-        if (whiteBishops & b) return WBISHOP;
-        if (whiteRooks & b)   return WROOK;
-        if (whiteQueens & b)  return WQUEEN;
-        if (whiteKing & b)    return WKING;
-
-        if (blackPawns & b)   return BPAWN;
-        if (blackKnights & b) return BKNIGHT;
-        if (blackBishops & b) return BBISHOP;
-        if (blackRooks & b)   return BROOK;
-        if (blackQueens & b)  return BQUEEN;
-        if (blackKing & b)    return BKING;
-
-        return EMPTY;// retorna enum Piece ou 0 se vazio
+    inline void removePiece(Piece p, int sq) {
+        uint64_t b = ~BB(sq);
+        pieces[sideOf(p)][typeOf(p)] &= b;
+        byColor[sideOf(p)] &= b;
+        occupied &= b;
+        board[sq] = EMPTY;
     }
+
+    inline void movePiece(Piece p, int from, int to) {
+        uint64_t fromTo = BB(from) | BB(to);
+        pieces[sideOf(p)][typeOf(p)] ^= fromTo;
+        byColor[sideOf(p)] ^= fromTo;
+        occupied ^= fromTo;
+        board[from] = EMPTY;
+        board[to] = p;
+    }
+
+    /**
+     * @brief Confere se o mailbox, as bitboards, byColor, occupied e o hash
+     * descrevem a mesma posição. Caro: feito para asserts e ferramentas de debug
+     * (nas builds com DEBUG, makeMove/unmakeMove o chamam a cada lance).
+     * @return true se tudo bate
+     */
+    bool isConsistent() const;
+
     /**
      * @brief 
-     * Cuida da lógica da aplicação do movimento. No momento, sem configurar roque,
-     * en passant e promoções
+     * Versão copy-make: copia o tabuleiro e aplica o lance na cópia (via makeMove).
+     * Os mapas de ataque da cópia ficam inválidos.
      * @param m -> Movimento a ser feito
      * @return -> Retorna o tabuleiro com o movimento aplicado
      */
     Board applyMove(const Move& m) const;
 
+    /**
+     * @brief Aplica o lance in-place (make/unmake), atualizando bitboards, hash,
+     * roque e en passant incrementalmente. Os dados para desfazer o lance
+     * são gravados em 'st'. Os mapas de ataque NÃO são recalculados.
+     * @param m -> Movimento a ser feito
+     * @param st -> Estado de undo do ply atual
+     */
+    void makeMove(const Move& m, StateInfo& st);
+
+    /**
+     * @brief Desfaz um lance aplicado com makeMove, restaurando o estado salvo
+     * em 'st' (incluindo os mapas de ataque).
+     * @param m -> O mesmo movimento passado para makeMove
+     * @param st -> O mesmo StateInfo preenchido por makeMove
+     */
+    void unmakeMove(const Move& m, const StateInfo& st);
+
+    /**
+     * @brief Lance nulo ("passe"): só troca o lado a jogar e limpa o en passant,
+     * atualizando o hash. As peças não mudam, então os mapas de ataque continuam válidos.
+     * O halfmoveClock anda como num lance quieto; quem zera é o pliesFromNull,
+     * para a detecção de repetições não atravessar o lance nulo.
+     * Usado pela busca (null move pruning); nunca é um lance legal.
+     * @param st -> Estado de undo do ply atual
+     */
+    void makeNullMove(StateInfo& st);
+
+    /**
+     * @brief Desfaz makeNullMove
+     */
+    void unmakeNullMove(const StateInfo& st);
+
+    /**
+     * @brief Retorna a bitboard que guarda o tipo de peça 'p'
+     */
+    inline uint64_t pieceBB(Piece p) const {
+        return pieces[sideOf(p)][typeOf(p)];
+    }
+
     /**
      * @brief 
      * Inicializa uma posição de xadrez 'Board' a partir de um FEN
@@ -110,18 +195,62 @@ struct Board {
     void computeHash();
     
     /**
-     * @brief Essa função constrói do zero um mapa de ataque que auxilia na geração
-     * de movimentos válidos para as peças. Num futuro update, podemos pensar em 
-     * uma implementação incremental, que não calcula tudo do zero.
+     * @brief Essa função constrói do zero os mapas de ataque. Depois disso makeMove
+     * os mantém incrementalmente (recalculando só os tipos de peça afetados pelo lance).
+     */
+    void updateAttackBoards() const;
+
+    /**
+     * @brief Garante que os mapas de ataque estão válidos (calcula se estiverem desatualizados)
+     */
+    inline void ensureAttacks() const {
+        if (!attacksValid) updateAttackBoards();
+    }
+
+    /**
+     * @brief Casas atacadas por uma cor (união de todos os tipos de peça)
+     */
+    inline uint64_t attacks(Side c) const {
+        ensureAttacks();
+        const uint64_t* a = attackedBy[c];
+        return a[PAWN] | a[KNIGHT] | a[BISHOP] | a[ROOK] | a[QUEEN] | a[KING];
+    }
+
+    /**
+     * @brief Casas atacadas pelas peças de um tipo e cor
+     */
+    inline uint64_t attacksBy(Side c, PieceType t) const {
+        ensureAttacks();
+        return attackedBy[c][t];
+    }
+
+    /**
+     * @brief O rei do lado a jogar está em xeque? Usa os mapas se estiverem válidos,
+     * senão consulta só os atacantes da casa do rei (sem forçar o cálculo dos mapas).
+     */
+    bool inCheck() const;
+
+    /**
+     * @brief Casas atacadas pelas peças de um tipo e cor, dada uma ocupação
+     */
+    uint64_t pieceAttacks(Side c, PieceType t, uint64_t occ) const;
+
+    /**
+     * @brief Calcula todas as casas atacadas por um lado, dada uma ocupação.
+     * Passar uma ocupação sem o rei adversário permite enxergar "através" dele
+     * (usado para as casas proibidas ao rei na geração legal).
+     * @param byWhite Lado atacante
+     * @param occ Máscara de ocupação usada para os bloqueios dos deslizantes
+     * @return Bitboard das casas atacadas
      */
-    void updateAttackBoards();
+    uint64_t attackedSquares(bool byWhite, uint64_t occ) const;
 
     /**
      * @brief Retorna bitboard de todas as peças que atacam 
-     * 'sq' (considerando blockers em 'occupied')
+     * 'sq' (considerando blockers em 'occ')
      * @param sq A casa (0, 63)
-     * @param occupied Máscara de ocupação do tabuleiro
+     * @param occ Máscara de ocupação do tabuleiro
      * @return 
      */
-    uint64_t attackersTo(int sq, uint64_t occupied) const;
+    uint64_t attackersTo(int sq, uint64_t occ) const;
 };
@@ -8,3 +8,26 @@ enum Piece : uint8_t {
     WPAWN, WKNIGHT, WBISHOP, WROOK, WQUEEN, WKING,
     BPAWN, BKNIGHT, BBISHOP, BROOK, BQUEEN, BKING
 };
+
+// Lado (cor) das peças. Não se chama Color para não colidir com o Color da raylib
+enum Side : uint8_t { SIDE_WHITE, SIDE_BLACK };
+
+// Lado oposto: ~SIDE_WHITE == SIDE_BLACK
+constexpr Side operator~(Side s) {
+    return Side(s ^ 1);
+}
+
+// Tipo da peça sem cor, usado para indexar tabelas [Side][PieceType]
+enum PieceType : uint8_t { PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING };
+
+constexpr Side sideOf(Piece p) {
+    return p >= BPAWN ? SIDE_BLACK : SIDE_WHITE;
+}
+
+constexpr PieceType typeOf(Piece p) {
+    return PieceType((p - 1) % 6);
+}
+
+constexpr Piece makePiece(Side c, PieceType t) {
+    return Piece(1 + c * 6 + t);
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+#include "../../board/board.h"
+#include "../../move/movegen.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Benchmark: mapas de ataque
+// ==========================================
+// Percorre a mesma árvore com make/unmake em três modos:
+//  - full: updateAttackBoards() do zero depois de cada lance (comportamento antigo)
+//  - incremental: makeMove recalcula só os tipos de peça afetados
+//  - lazy: makeMove só invalida; os mapas são calculados quando a geração pede
+// No modo incremental cada nó é conferido contra uma reconstrução completa.
+
+enum class Mode { FULL, INCREMENTAL, LAZY };
+
+static bool checkIncremental(const Board& board) {
+    Board fresh = board;
+    fresh.updateAttackBoards();
+    return std::memcmp(fresh.attackedBy, board.attackedBy, sizeof(board.attackedBy)) == 0;
+}
+
+static uint64_t perft(Board& board, int depth, Mode mode, bool& ok) {
+    MoveList moves = MoveGen::generateMoves(board);
+    if (depth == 1) return moves.size();
+
+    uint64_t nodes = 0;
+    for (const auto& m : moves) {
+        StateInfo st;
+        board.makeMove(m, st);
+        if (mode == Mode::FULL) board.updateAttackBoards();
+        if (mode == Mode::INCREMENTAL && ok && !checkIncremental(board)) ok = false;
+
+        nodes += perft(board, depth - 1, mode, ok);
+        board.unmakeMove(m, st);
+    }
+    return nodes;
+}
+
+static double timeMode(Board board, int depth, Mode mode, uint64_t& nodes, bool& ok) {
+    board.lazyAttacks = (mode == Mode::LAZY);
+    board.updateAttackBoards();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    nodes = perft(board, depth, mode, ok);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    Zobrist::init();
+
+    struct BenchPos { const char* name; const char* fen; int depth; };
+    const BenchPos positions[] = {
+        {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4},
+        {"pos3",     "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5},
+        {"pos4",     "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4},
+    };
+
+    for (const auto& p : positions) {
+        Board board = Board::fromFEN(p.fen);
+
+        // Conferência (fora da medição de tempo)
+        bool ok = true;
+        uint64_t checked = 0;
+        timeMode(board, p.depth - 1, Mode::INCREMENTAL, checked, ok);
+
+        bool dummy = false;
+        uint64_t nFull = 0, nInc = 0, nLazy = 0;
+        double msFull = timeMode(board, p.depth, Mode::FULL, nFull, dummy);
+        double msInc  = timeMode(board, p.depth, Mode::INCREMENTAL, nInc, dummy);
+        double msLazy = timeMode(board, p.depth, Mode::LAZY, nLazy, dummy);
+
+        std::cout << "=== " << p.name << " (perft " << p.depth << ") ===\n";
+        std::cout << "  incremental == full rebuild: " << (ok ? "OK" : "ERRO") << "\n";
+        std::cout << "  full       : " << nFull << " nodes, " << msFull << " ms\n";
+        std::cout << "  incremental: " << nInc  << " nodes, " << msInc  << " ms\n";
+        std::cout << "  lazy       : " << nLazy << " nodes, " << msLazy << " ms\n\n";
+
+        if (!ok) return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../board/board.h"
+#include "../../search/search.h"
+#include "../../tt/tt.h"
+
+// ==========================================
+//  Peças comuns dos benchmarks de src/debug/bench
+// ==========================================
+// Posições, medição de tempo e tabela de saída usadas por mais de uma
+// ferramenta. NPS de profundidade fixa fica com o "bench" do capy_uci.
+
+// Posições das buscas de profundidade fixa (abertura, meio-jogo e finais)
+inline constexpr const char* BENCH_FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "r2q1rk1/pp2bppp/2n1pn2/3p4/3P4/2NBPN2/PP3PPP/R2Q1RK1 b - - 0 10",
+    "2rq1rk1/pp1bppbp/2np1np1/8/3NP3/1BN1BP2/PPPQ2PP/2KR3R b - - 0 11",
+    "8/5pk1/6p1/3P4/1p3P2/1P4PK/8/8 w - - 0 45",
+};
+
+template<size_t N>
+std::vector<Board> boardsFromFENs(const char* const (&fens)[N]) {
+    std::vector<Board> boards;
+    for (const char* fen : fens) boards.push_back(Board::fromFEN(fen));
+    return boards;
+}
+
+// Impede o compilador de descartar o resultado de um laço medido
+inline volatile uint64_t sink;
+
+/**
+ * @brief Roda f() uma vez e devolve o tempo dividido por 'ops', em ns
+ */
+template<typename F>
+double nsPerOp(F&& f, uint64_t ops) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+// Resultado de buscas de profundidade fixa: nós contam busca + q-search
+struct SearchRun {
+    uint64_t nodes = 0;
+    double seconds = 0;
+    SearchStats stats;
+
+    SearchRun& operator+=(const SearchRun& other) {
+        nodes += other.nodes;
+        seconds += other.seconds;
+        stats += other.stats;
+        return *this;
+    }
+
+    double nps() const { return nodes / seconds; }
+};
+
+/**
+ * @brief Busca cada posição até 'depth', com a TT limpa antes de cada uma
+ * (contagem de nós determinística com uma thread), e soma os resultados
+ */
+inline SearchRun searchFixedDepth(Searcher& searcher, const std::vector<Board>& boards, int depth) {
+    SearchRun total;
+    for (const Board& board : boards) {
+        TT.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        searcher.searchBestMove(board, depth);
+        auto end = std::chrono::steady_clock::now();
+
+        SearchRun r;
+        r.stats = searcher.lastStats();
+        r.nodes = r.stats.nodes + r.stats.qnodes;
+        r.seconds = std::chrono::duration<double>(end - start).count();
+        total += r;
+    }
+    return total;
+}
+
+// Número com 'precision' casas decimais, para as células da tabela
+inline std::string formatFixed(double value, int precision) {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(precision) << value;
+    return os.str();
+}
+
+/**
+ * @brief Tabela de texto com colunas alinhadas à esquerda. A última coluna
+ * não tem largura (vai até o fim da linha). A largura conta caracteres, não
+ * bytes, então cabeçalhos com acento ("Nós") alinham com os números
+ */
+class Table {
+public:
+    Table(std::initializer_list<int> columnWidths) : widths(columnWidths) {}
+
+    void row(std::initializer_list<std::string> cells) const {
+        size_t i = 0;
+        for (const std::string& cell : cells) {
+            std::cout << cell;
+            if (i < widths.size()) {
+                int chars = 0;
+                for (unsigned char c : cell) chars += (c & 0xC0) != 0x80; // Ignora bytes de continuação UTF-8
+                std::cout << std::string(std::max(0, widths[i] - chars), ' ');
+            }
+            ++i;
+        }
+        std::cout << "\n";
+    }
+
+private:
+    std::vector<int> widths;
+};
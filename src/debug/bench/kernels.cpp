@@ -0,0 +1,292 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <functional>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_RDTSC 1
+#endif
+
+#include "common.h"
+#include "../../move/movegen.h"
+#include "../../eval/eval.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Benchmark: kernels da engine
+// ==========================================
+// Mede cada kernel isolado sobre um corpus de posições realistas: as posições
+// abaixo mais as alcançadas por partidas aleatórias curtas a partir delas.
+// Cada kernel roda em rodadas de pelo menos ROUND_MS; vale a melhor de ROUNDS
+// (a menos perturbada pelo sistema). Mostra ns/op e, em x86, ciclos/op do TSC
+// (ciclos de referência, não os do núcleo com turbo).
+//
+// Kernels:
+//  - generateMoves, generateWinningMoves, Eval::evaluate, updateAttackBoards: por posição
+//  - applyMove, moveToSAN: por lance legal
+//  - attackersTo: por casa (64 por posição)
+//  - see: por captura que passa pela SEE (MoveGen::goodCapture com vítima <= atacante)
+//  - TT store/probe: chaves do corpus, com tabelas de 1, 16 e 256 MB (probe: metade acertos, metade erros)
+//  - fromFEN: por FEN
+//
+// Uso: make debug-tool NAME=bench/kernels ARGS="[filtro]"
+// (o filtro roda só os kernels cujo nome contém o texto, ex: "TT")
+
+static const char* FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "r2q1rk1/pp2bppp/2n1pn2/3p4/3P4/2NBPN2/PP3PPP/R2Q1RK1 b - - 0 10",
+    "2rq1rk1/pp1bppbp/2np1np1/8/3NP3/1BN1BP2/PPPQ2PP/2KR3R b - - 0 11",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",
+    "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - - 0 23",
+    "6k1/3b3r/1p1p4/p1n2p2/1PPNpP1q/P3Q1p1/1R1RB1P1/5K2 b - - 0 1",
+    "8/5pk1/6p1/3P4/1p3P2/1P4PK/8/8 w - - 0 45",
+    "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/8 b - - 0 1",
+    "8/R7/2q5/8/6k1/8/1P5p/K6R w - - 0 124",
+    "8/8/1P6/5pr1/8/4R3/7k/2K5 w - - 0 1",
+    "3r1k2/4npp1/1ppr3p/p6P/P2PPPP1/1NR5/5K2/2R5 w - - 0 1",
+};
+
+// Partidas aleatórias por posição inicial e meios-lances de cada uma
+static constexpr int PLAYOUTS = 12;
+static constexpr int PLAYOUT_PLIES = 8;
+
+static constexpr int ROUNDS = 5;
+static constexpr double ROUND_MS = 100;
+
+static const int TT_SIZES_MB[] = { 1, 16, 256 };
+
+// Rodadas de store feitas antes do probe, rode ou não o benchmark de store
+static constexpr int TT_FILL_ROUNDS = 8;
+
+// xorshift64: corpus igual em toda execução
+static uint64_t nextRandom(uint64_t& s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+static std::vector<Board> buildCorpus() {
+    std::vector<Board> corpus;
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    for (const char* fen : FENS) {
+        Board root = Board::fromFEN(fen);
+        corpus.push_back(root);
+
+        for (int p = 0; p < PLAYOUTS; ++p) {
+            Board b = root;
+            for (int ply = 0; ply < PLAYOUT_PLIES; ++ply) {
+                MoveList moves = MoveGen::generateMoves(b);
+                if (moves.empty()) break;
+
+                b = b.applyMove(moves[nextRandom(seed) % moves.size()]);
+                b.updateAttackBoards();
+                corpus.push_back(b);
+            }
+        }
+    }
+    return corpus;
+}
+
+static inline uint64_t readCycles() {
+#ifdef HAS_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct Sample {
+    double ns = 0;
+    double cycles = 0;
+};
+
+/**
+ * @brief Roda 'body' (que executa 'ops' operações) em rodadas de pelo menos
+ * ROUND_MS e devolve o custo por operação da melhor rodada
+ */
+static Sample measure(const std::function<uint64_t()>& body, uint64_t ops) {
+    sink = sink + body(); // Aquece caches e branch predictor
+
+    Sample best;
+    for (int round = 0; round < ROUNDS; ++round) {
+        uint64_t reps = 0;
+        uint64_t acc = 0;
+        double ns = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t c0 = readCycles();
+        do {
+            acc += body();
+            ++reps;
+            ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        } while (ns < ROUND_MS * 1e6);
+        uint64_t c1 = readCycles();
+        sink = sink + acc;
+
+        double total = double(reps) * ops;
+        Sample s{ ns / total, double(c1 - c0) / total };
+        if (round == 0 || s.ns < best.ns) best = s;
+    }
+    return best;
+}
+
+static void printRow(const std::string& name, uint64_t ops, const Sample& s) {
+    std::cout << std::left << std::setw(26) << name << std::right << std::setw(10) << ops
+              << std::setw(12) << std::fixed << std::setprecision(1) << s.ns;
+#ifdef HAS_RDTSC
+    std::cout << std::setw(14) << s.cycles;
+#else
+    std::cout << std::setw(14) << "-";
+#endif
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter = (argc > 1) ? argv[1] : "";
+    Zobrist::init();
+
+    std::vector<Board> corpus = buildCorpus();
+
+    // Lances legais e capturas que passam pela SEE, guardados uma vez para não medir a geração junto
+    std::vector<std::pair<const Board*, Move>> legalMoves, seeCaptures;
+    for (const Board& b : corpus) {
+        for (const Move& m : MoveGen::generateMoves(b)) {
+            legalMoves.push_back({ &b, m });
+
+            if (!(m.flags() & CAPTURE) || (m.flags() & EN_PASSANT)) continue;
+            if (MVV_LVA_VALUES[b.pieceAt(m.to)] <= MVV_LVA_VALUES[b.pieceAt(m.from)]) {
+                seeCaptures.push_back({ &b, m });
+            }
+        }
+    }
+
+    std::cout << "Corpus: " << corpus.size() << " posições, " << legalMoves.size()
+              << " lances, " << seeCaptures.size() << " capturas com SEE\n\n";
+    std::cout << std::left << std::setw(26) << "Kernel" << std::right << std::setw(10) << "ops"
+              << std::setw(12) << "ns/op" << std::setw(14) << "ciclos/op" << "\n";
+
+    auto run = [&](const std::string& name, uint64_t ops, const std::function<uint64_t()>& body) {
+        if (name.find(filter) == std::string::npos) return;
+        printRow(name, ops, measure(body, ops));
+    };
+
+    // ===== Geração de lances =====
+    run("generateMoves", corpus.size(), [&] {
+        uint64_t n = 0;
+        for (const Board& b : corpus) n += MoveGen::generateMoves(b).size();
+        return n;
+    });
+
+    run("generateWinningMoves", corpus.size(), [&] {
+        uint64_t n = 0;
+        for (const Board& b : corpus) n += MoveGen::generateWinningMoves(b).size();
+        return n;
+    });
+
+    // ===== Tabuleiro =====
+    run("applyMove", legalMoves.size(), [&] {
+        uint64_t h = 0;
+        for (const auto& [b, m] : legalMoves) h ^= b->applyMove(m).hashKey;
+        return h;
+    });
+
+    run("updateAttackBoards", corpus.size(), [&] {
+        uint64_t h = 0;
+        for (const Board& b : corpus) {
+            b.updateAttackBoards();
+            h ^= b.attackedBy[SIDE_WHITE][QUEEN];
+        }
+        return h;
+    });
+
+    run("attackersTo", corpus.size() * 64, [&] {
+        uint64_t h = 0;
+        for (const Board& b : corpus) {
+            uint64_t occ = b.allPieces();
+            for (int sq = 0; sq < 64; ++sq) h ^= b.attackersTo(sq, occ);
+        }
+        return h;
+    });
+
+    run("see", seeCaptures.size(), [&] {
+        uint64_t n = 0;
+        for (const auto& [b, m] : seeCaptures) n += MoveGen::goodCapture(*b, m);
+        return n;
+    });
+
+    // ===== Avaliação =====
+    run("Eval::evaluate", corpus.size(), [&] {
+        uint64_t s = 0;
+        for (const Board& b : corpus) s += Eval::evaluate(b);
+        return s;
+    });
+
+    // ===== Transposition table =====
+    for (int mb : TT_SIZES_MB) {
+        std::string size = std::to_string(mb) + " MB";
+        if (("TT.store " + size).find(filter) == std::string::npos &&
+            ("TT.probe " + size).find(filter) == std::string::npos) continue;
+
+        TranspositionTable tt;
+        tt.resize(mb);
+
+        // Chaves do corpus misturadas com a rodada: cada rodada cai em clusters
+        // diferentes, então nas tabelas grandes o acesso sai da cache como na busca
+        uint64_t round = 0;
+        auto storeRound = [&]() -> uint64_t {
+            uint64_t salt = ++round * 0x9E3779B97F4A7C15ULL;
+            for (const Board& b : corpus) tt.store(b.hashKey ^ salt, 5, 0, TT_EXACT, Move{}, 0);
+            return salt;
+        };
+        run("TT.store " + size, corpus.size(), storeRound);
+
+        // O probe precisa da tabela cheia mesmo se o filtro pulou o store
+        for (int i = 0; i < TT_FILL_ROUNDS; ++i) storeRound();
+
+        // Metade das chaves é de uma rodada já guardada (acerto, se não foi
+        // substituída), metade nunca foi guardada (erro)
+        uint64_t storedRounds = round;
+        run("TT.probe " + size, corpus.size(), [&] {
+            ++round;
+            uint64_t hitSalt  = (round % storedRounds + 1) * 0x9E3779B97F4A7C15ULL;
+            uint64_t missSalt = (storedRounds + round) * 0x9E3779B97F4A7C15ULL;
+
+            uint64_t hits = 0;
+            TTEntry entry;
+            for (size_t i = 0; i < corpus.size(); ++i) {
+                uint64_t key = corpus[i].hashKey ^ ((i & 1) ? missSalt : hitSalt);
+                hits += tt.probe(key, entry, 0);
+            }
+            return hits;
+        });
+    }
+
+    // ===== Notação =====
+    run("moveToSAN", legalMoves.size(), [&] {
+        uint64_t n = 0;
+        for (const auto& [b, m] : legalMoves) n += moveToSAN(m, *b).size();
+        return n;
+    });
+
+    run("fromFEN", std::size(FENS), [&] {
+        uint64_t h = 0;
+        for (const char* fen : FENS) h ^= Board::fromFEN(fen).hashKey;
+        return h;
+    });
+
+    return 0;
+}
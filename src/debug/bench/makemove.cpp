@@ -0,0 +1,121 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+#include "../../board/board.h"
+#include "../../move/movegen.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Benchmark: copy-make (applyMove) vs make/unmake
+// ==========================================
+// Percorre a mesma árvore (perft) das duas formas e compara o tempo.
+// Também verifica se unmakeMove restaura o tabuleiro bit a bit.
+
+static uint64_t perftCopy(const Board& board, int depth) {
+    MoveList moves = MoveGen::generateMoves(board);
+    if (depth == 1) return moves.size();
+
+    uint64_t nodes = 0;
+    for (const auto& m : moves) {
+        Board next = board.applyMove(m);
+        next.updateAttackBoards();
+        nodes += perftCopy(next, depth - 1);
+    }
+    return nodes;
+}
+
+static uint64_t perftMake(Board& board, int depth) {
+    MoveList moves = MoveGen::generateMoves(board);
+    if (depth == 1) return moves.size();
+
+    uint64_t nodes = 0;
+    for (const auto& m : moves) {
+        StateInfo st;
+        board.makeMove(m, st);
+        board.updateAttackBoards();
+        nodes += perftMake(board, depth - 1);
+        board.unmakeMove(m, st);
+    }
+    return nodes;
+}
+
+// Custo isolado de aplicar/desfazer lances (sem geração nem mapas de ataque)
+static double applyOnlyNs(Board& board, const MoveList& moves, int reps, bool copyMake) {
+    uint64_t sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (int r = 0; r < reps; ++r) {
+        for (const auto& m : moves) {
+            if (copyMake) {
+                Board next = board.applyMove(m);
+                sink ^= next.hashKey;
+            } else {
+                StateInfo st;
+                board.makeMove(m, st);
+                sink ^= board.hashKey;
+                board.unmakeMove(m, st);
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    if (sink == 42) std::cout << "";
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (double(reps) * moves.size());
+}
+
+int main() {
+    Zobrist::init();
+
+    struct BenchPos { const char* name; const char* fen; int depth; };
+    const BenchPos positions[] = {
+        {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3},
+        {"pos3",     "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5},
+    };
+
+    for (const auto& p : positions) {
+        Board board = Board::fromFEN(p.fen);
+        board.updateAttackBoards();
+
+        // Verificação: make + unmake deve devolver exatamente o mesmo tabuleiro
+        for (const auto& m : MoveGen::generateMoves(board)) {
+            Board before = board;
+            StateInfo st;
+            board.makeMove(m, st);
+            Board copy = before.applyMove(m);
+            if (copy.hashKey != board.hashKey) {
+                std::cout << "ERRO: hash divergente entre makeMove e applyMove\n";
+                return 1;
+            }
+            board.unmakeMove(m, st);
+            if (std::memcmp(&before, &board, sizeof(Board)) != 0) {
+                std::cout << "ERRO: unmakeMove nao restaurou o tabuleiro\n";
+                return 1;
+            }
+        }
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        uint64_t nCopy = perftCopy(board, p.depth);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        uint64_t nMake = perftMake(board, p.depth);
+        auto t2 = std::chrono::high_resolution_clock::now();
+
+        double msCopy = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double msMake = std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+        MoveList rootMoves = MoveGen::generateMoves(board);
+        double nsCopy = applyOnlyNs(board, rootMoves, 200000, true);
+        double nsMake = applyOnlyNs(board, rootMoves, 200000, false);
+
+        std::cout << "=== " << p.name << " (perft " << p.depth << ") ===\n";
+        std::cout << "  copy-make : " << nCopy << " nodes, " << msCopy << " ms\n";
+        std::cout << "  make/undo : " << nMake << " nodes, " << msMake << " ms\n";
+        std::cout << "  apply only: copy " << nsCopy << " ns/lance, make+unmake " << nsMake << " ns/lance\n";
+        std::cout << "  sizeof(Board) = " << sizeof(Board) << " bytes, sizeof(StateInfo) = " << sizeof(StateInfo) << " bytes\n\n";
+    }
+
+    return 0;
+}
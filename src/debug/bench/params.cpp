@@ -0,0 +1,73 @@
+#include <cstdlib>
+#include <string>
+
+#include "common.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Benchmark: efeito de cada técnica da busca
+// ==========================================
+// Busca de profundidade fixa no mesmo conjunto de posições com todas as
+// técnicas de SearchParams ligadas e, depois, desligando uma de cada vez.
+// Mostra os nós e o tempo de cada configuração e a diferença em relação à
+// busca completa (positivo = a técnica economiza nós).
+// No fim, as re-buscas da janela de aspiração por profundidade.
+//
+// Uso: make debug-tool NAME=bench/params ARGS="[depth]"
+
+// Técnicas que podem ser desligadas
+struct Feature {
+    const char* name;
+    bool SearchParams::* flag;
+};
+
+static const Feature FEATURES[] = {
+    { "aspiration", &SearchParams::useAspiration },
+    { "pvs",        &SearchParams::usePVS },
+    { "null move",  &SearchParams::useNullMove },
+    { "lmr",        &SearchParams::useLMR },
+    { "rfp",        &SearchParams::useRFP },
+    { "razoring",   &SearchParams::useRazoring },
+    { "futility",   &SearchParams::useFutility },
+    { "lmp",        &SearchParams::useLMP },
+};
+
+static void printRow(const Table& table, const std::string& name, const SearchRun& r, const SearchRun& base) {
+    double saved = 100.0 * (double(r.nodes) - double(base.nodes)) / double(r.nodes);
+    table.row({ name, std::to_string(r.nodes), formatFixed(r.seconds * 1000, 1),
+                (saved >= 0 ? "+" : "") + formatFixed(saved, 1) + "%" });
+}
+
+int main(int argc, char* argv[]) {
+    int depth = (argc > 1) ? std::atoi(argv[1]) : 7;
+
+    Zobrist::init();
+    TT.resize(64);
+    Searcher searcher(TT);
+
+    std::vector<Board> boards = boardsFromFENs(BENCH_FENS);
+
+    Table table{ 16, 14, 10 };
+    table.row({ "Config", "Nós", "ms", "Economia" });
+
+    SearchRun base = searchFixedDepth(searcher, boards, depth);
+    printRow(table, "tudo ligado", base, base);
+
+    for (const Feature& f : FEATURES) {
+        SearchParams& params = searcher.params();
+        params.*f.flag = false;
+
+        printRow(table, std::string("sem ") + f.name, searchFixedDepth(searcher, boards, depth), base);
+
+        params.*f.flag = true;
+    }
+
+    std::cout << "\nRe-buscas da aspiração por profundidade:\n";
+    Table researches{ 2, 8 };
+    researches.row({ "", "Depth", "Re-buscas" });
+    for (int d = 1; d <= depth && d < MAX_PLY; ++d) {
+        researches.row({ "", std::to_string(d), std::to_string(base.stats.aspirationResearches[d]) });
+    }
+
+    return 0;
+}
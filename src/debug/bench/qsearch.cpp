@@ -0,0 +1,113 @@
+#include <cstdlib>
+
+#include "common.h"
+#include "../../move/movegen.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Benchmark: pieceAt e q-search em posições cheias de capturas
+// ==========================================
+// 1. pieceAt pelo mailbox contra a varredura das 12 bitboards (como era antes),
+//    conferindo que as duas respostas batem em todas as casas.
+// 2. Laço de capturas: o trabalho de um nó de q-search (gerar capturas,
+//    MVV-LVA, SEE e make/unmake), onde o pieceAt é chamado várias vezes por lance.
+// 3. Busca de profundidade fixa, separando os nós de q-search.
+//
+// Uso: make debug-tool NAME=bench/qsearch ARGS="[depth]"
+
+static const char* FENS[] = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1b1k2r/ppp2ppp/2n5/2bqp3/3Pn3/2P2N2/PP2BPPP/RNBQK2R w KQkq - 0 8",
+    "2rq1rk1/pp1bppbp/2np1np1/8/3NP3/1BN1BP2/PPPQ2PP/2KR3R b - - 0 11",
+    "r2q1rk1/1b2bppp/p2p1n2/npp1p3/3PP3/2P2N1P/PPB2PP1/RNBQR1K1 w - - 0 12",
+    "3r1rk1/p1q2ppp/1pn1pn2/2b5/2P1N3/P3PN2/1BQ2PPP/3R1RK1 w - - 0 17",
+    "r1bq1rk1/pp3ppp/2n1pn2/2bp4/2P5/2N1PN2/PPQ2PPP/R1B1KB1R w KQ - 0 8",
+};
+
+// Como o pieceAt era antes do mailbox: testa a ocupação, a cor e os tipos
+static Piece pieceAtScan(const Board& b, int sq) {
+    uint64_t bb = BB(sq);
+    if (!(b.occupied & bb)) return EMPTY;
+
+    Side c = (b.byColor[SIDE_WHITE] & bb) ? SIDE_WHITE : SIDE_BLACK;
+    for (int t = PAWN; t < KING; ++t) {
+        if (b.pieces[c][t] & bb) return makePiece(c, PieceType(t));
+    }
+    return makePiece(c, KING);
+}
+
+template<typename Lookup>
+static double pieceAtNs(const std::vector<Board>& boards, int reps, Lookup lookup) {
+    return nsPerOp([&]() {
+        uint64_t acc = 0;
+        for (int r = 0; r < reps; ++r)
+            for (const Board& b : boards)
+                for (int sq = 0; sq < 64; ++sq)
+                    acc += lookup(b, sq);
+        sink = acc;
+    }, uint64_t(reps) * boards.size() * 64);
+}
+
+int main(int argc, char* argv[]) {
+    int depth = (argc > 1) ? std::atoi(argv[1]) : 6;
+
+    Zobrist::init();
+    TT.resize(64);
+    Searcher searcher(TT);
+
+    std::vector<Board> boards = boardsFromFENs(FENS);
+
+    // --- 1. pieceAt ---
+    uint64_t mismatches = 0;
+    for (const Board& b : boards) {
+        if (!b.isConsistent()) ++mismatches;
+        for (int sq = 0; sq < 64; ++sq)
+            mismatches += b.pieceAt(sq) != pieceAtScan(b, sq);
+    }
+
+    const int reps = 20000;
+    double mailboxNs = pieceAtNs(boards, reps, [](const Board& b, int sq) { return b.pieceAt(sq); });
+    double scanNs    = pieceAtNs(boards, reps, pieceAtScan);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "pieceAt (ns/op)\n";
+    std::cout << "  mailbox:    " << mailboxNs << "\n";
+    std::cout << "  bitboards:  " << scanNs << "\n";
+    std::cout << "  Divergências: " << mismatches << "\n";
+
+    // --- 2. Laço de capturas ---
+    const int iterations = 200000;
+    uint64_t captures = 0;
+
+    double loopNs = nsPerOp([&]() {
+        uint64_t acc = 0;
+        for (int i = 0; i < iterations; ++i) {
+            Board& b = boards[i % boards.size()];
+            MoveList moves = MoveGen::generateWinningMoves(b);
+            for (int j = 0; j < moves.size(); ++j) {
+                const Move& m = moves[j];
+                acc += moves.score(j) + MoveGen::goodCapture(b, m);
+                StateInfo st;
+                b.makeMove(m, st);
+                acc ^= b.hashKey;
+                b.unmakeMove(m, st);
+            }
+            captures += moves.size();
+        }
+        sink = acc;
+    }, iterations);
+
+    std::cout << "\nLaço de capturas: " << loopNs << " ns/pos (" << captures << " capturas)\n";
+
+    // --- 3. Busca ---
+    SearchRun r = searchFixedDepth(searcher, boards, depth);
+
+    std::cout << "\nBusca depth " << depth << ": " << r.nodes << " nós ("
+              << std::setprecision(1) << 100.0 * r.stats.qnodes / r.nodes << "% q-search) em "
+              << std::setprecision(3) << r.seconds << " s -> "
+              << std::setprecision(0) << r.nps() << " nps\n";
+
+    return mismatches == 0 ? 0 : 1;
+}
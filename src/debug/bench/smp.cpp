@@ -0,0 +1,43 @@
+#include <cstdlib>
+
+#include "common.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Benchmark: escalabilidade do Lazy SMP
+// ==========================================
+// Para cada número de threads (1, 2, 4, 8, 16 até o máximo pedido) busca as
+// mesmas posições até a mesma profundidade, com a TT limpa antes de cada uma.
+//  - Tempo até a profundidade (time-to-depth) e o speedup em relação a 1 thread
+//  - NPS somado de todas as threads
+// No Lazy SMP o número de nós cresce com as threads (as buscas se sobrepõem),
+// então o speedup real é o de tempo, não o de NPS.
+//
+// Uso: make debug-tool NAME=bench/smp ARGS="[depth] [maxThreads]"
+
+int main(int argc, char* argv[]) {
+    int depth = (argc > 1) ? std::atoi(argv[1]) : 7;
+    int maxThreads = (argc > 2) ? std::atoi(argv[2]) : 16;
+
+    Zobrist::init();
+    TT.resize(64);
+    Searcher searcher(TT);
+
+    std::vector<Board> boards = boardsFromFENs(BENCH_FENS);
+    double baseSeconds = 0;
+
+    Table table{ 9, 14, 10, 12 };
+    table.row({ "Threads", "Nós", "ms", "knps", "Speedup" });
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        searcher.setThreads(threads);
+
+        SearchRun r = searchFixedDepth(searcher, boards, depth);
+        if (threads == 1) baseSeconds = r.seconds;
+
+        table.row({ std::to_string(threads), std::to_string(r.nodes), formatFixed(r.seconds * 1000, 1),
+                    formatFixed(r.nps() / 1000, 0), formatFixed(baseSeconds / r.seconds, 2) + "x" });
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <cstdlib>
+#include <new>
+
+#include "../../board/board.h"
+#include "../../move/movegen.h"
+#include "../../search/search.h"
+#include "../../tt/tt.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Teste: a busca não deve alocar no heap
+// ==========================================
+// Substitui o operator new/delete global por versões que contam chamadas.
+// Depois do aquecimento (TT e tabelas já alocadas), uma busca de
+// profundidade fixa deve terminar com zero alocações.
+
+static bool g_counting = false;
+static uint64_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+    if (g_counting) ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static const char* FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+
+int main(int argc, char* argv[]) {
+    int depth = (argc > 1) ? std::atoi(argv[1]) : 5;
+
+    Zobrist::init();
+    TT.resize(64);
+    Searcher searcher(TT);
+
+    bool ok = true;
+    for (const char* fen : FENS) {
+        Board board = Board::fromFEN(fen);
+
+        // Aquecimento: qualquer alocação preguiçosa acontece aqui
+        searcher.searchBestMove(board, 1);
+        TT.clear();
+
+        g_allocations = 0;
+        g_counting = true;
+        MoveList moves = MoveGen::generateMoves(board);
+        searcher.searchBestMove(board, depth);
+        g_counting = false;
+
+        std::cout << (g_allocations == 0 ? "[OK]   " : "[FAIL] ")
+                  << g_allocations << " alocações em " << moves.size()
+                  << " lances raiz, depth " << depth << " | " << fen << "\n";
+        if (g_allocations != 0) ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -32,12 +32,13 @@ int parseSq(std::string s) {
 // Converte Move para String ("e2e4")
 std::string moveStr(const Move& m) {
     std::string s = sqStr(m.from) + sqStr(m.to);
-    if (m.flags & PROMOTION) {
-        switch (m.promotion) {
+    if (m.flags() & PROMOTION) {
+        switch (m.promotion()) {
             case WQUEEN: case BQUEEN: s += 'q'; break;
             case WROOK:  case BROOK:  s += 'r'; break;
             case WBISHOP: case BBISHOP: s += 'b'; break;
             case WKNIGHT: case BKNIGHT: s += 'n'; break;
+            default: break;
         }
     }
     return s;
@@ -83,6 +84,7 @@ int main(int argc, char* argv[]) {
     }
     
     Board board = Board::fromFEN(startFen.c_str());
+    Searcher searcher(TT);
     int depth = 5;
 
     std::cout << "=== CHESS ENGINE PROTOTYPE ===\n";
@@ -98,12 +100,10 @@ int main(int argc, char* argv[]) {
 
         printBoard(board);
 
-        std::vector<Move> legalMoves = MoveGen::generateMoves(board);
+        MoveList legalMoves = MoveGen::generateMoves(board);
 
         if (legalMoves.empty()) {
-            bool inCheck = board.whiteToMove 
-                           ? (board.whiteKing & board.blackAttacks)
-                           : (board.blackKing & board.whiteAttacks);
+            bool inCheck = board.inCheck();
             std::cout << "FIM DE JOGO: " << (inCheck ? "Xeque-Mate!" : "Afogamento (Empate)") << "\n";
             break;
         }
@@ -112,7 +112,7 @@ int main(int argc, char* argv[]) {
         std::cout.flush();
 
         auto start = std::chrono::high_resolution_clock::now();
-        Move bestMove = Search::searchBestMove(board, depth);
+        Move bestMove = searcher.searchBestMove(board, depth);
         auto end = std::chrono::high_resolution_clock::now();
         
         long ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
@@ -32,12 +32,13 @@ int parseSq(std::string s) {
 // Converte Move para String ("e2e4")
 std::string moveStr(const Move& m) {
     std::string s = sqStr(m.from) + sqStr(m.to);
-    if (m.flags & PROMOTION) {
-        switch (m.promotion) {
+    if (m.flags() & PROMOTION) {
+        switch (m.promotion()) {
             case WQUEEN: case BQUEEN: s += 'q'; break;
             case WROOK:  case BROOK:  s += 'r'; break;
             case WBISHOP: case BBISHOP: s += 'b'; break;
             case WKNIGHT: case BKNIGHT: s += 'n'; break;
+            default: break;
         }
     }
     return s;
@@ -71,6 +72,7 @@ void printBoard(const Board& b) {
 }
 
 int main() {
+    Searcher searcher(TT);
     
     // Posições de mate
     constexpr std::array<std::string_view, 10> positions = {{
@@ -95,12 +97,10 @@ int main() {
 
             printBoard(board);
 
-            std::vector<Move> legalMoves = MoveGen::generateMoves(board);
+            MoveList legalMoves = MoveGen::generateMoves(board);
 
             if (legalMoves.empty()) {
-                bool inCheck = board.whiteToMove 
-                               ? (board.whiteKing & board.blackAttacks)
-                               : (board.blackKing & board.whiteAttacks);
+                bool inCheck = board.inCheck();
                 std::cout << "FIM DE JOGO: " << (inCheck ? "Xeque-Mate!" : "Afogamento (Empate)") << "\n";
                 break;
             }
@@ -109,7 +109,7 @@ int main() {
             std::cout.flush();
 
             auto start = std::chrono::high_resolution_clock::now();
-            Move bestMove = Search::searchBestMove(board, depth);
+            Move bestMove = searcher.searchBestMove(board, depth);
             auto end = std::chrono::high_resolution_clock::now();
             
             long ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
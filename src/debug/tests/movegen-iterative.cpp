@@ -28,12 +28,13 @@ std::string moveToString(const Move& m) {
     std::string res = squareToString(m.from) + squareToString(m.to);
     
     // Adiciona sufixo de promoção se houver
-    if (m.flags & PROMOTION) {
-        switch (m.promotion) {
+    if (m.flags() & PROMOTION) {
+        switch (m.promotion()) {
             case WQUEEN:  case BQUEEN:  res += 'q'; break;
             case WROOK:   case BROOK:   res += 'r'; break;
             case WBISHOP: case BBISHOP: res += 'b'; break;
             case WKNIGHT: case BKNIGHT: res += 'n'; break;
+            default: break;
         }
     }
     return res;
@@ -57,7 +58,7 @@ int main() {
         board.updateAttackBoards();
 
         // 3. Gera movimentos válidos
-        std::vector<Move> legalMoves = MoveGen::generateMoves(board);
+        MoveList legalMoves = MoveGen::generateMoves(board);
 
         // 4. Imprime Interface
         Debug::printBoard(board);
@@ -66,8 +67,7 @@ int main() {
         // Verifica fim de jogo
         if (legalMoves.empty()) {
             // Se não tem lances e o rei está em ataque = Xeque-mate
-            bool inCheck = (board.whiteToMove && (board.whiteKing & board.blackAttacks)) ||
-                           (!board.whiteToMove && (board.blackKing & board.whiteAttacks));
+            bool inCheck = board.inCheck();
             
             std::cout << "\n=== FIM DE JOGO ===\n";
             if (inCheck) {
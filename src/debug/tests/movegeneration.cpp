@@ -20,7 +20,7 @@ int main() {
     Debug::printAttackMaps(board);
 
     auto start = std::chrono::high_resolution_clock::now();
-    std::vector<Move> moves = MoveGen::generateMoves(board);
+    MoveList moves = MoveGen::generateMoves(board);
     auto end = std::chrono::high_resolution_clock::now();
     
     std::cout << "Movimentos gerados: " << moves.size() << "\n";
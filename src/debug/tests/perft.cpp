@@ -0,0 +1,283 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+#include "../../board/board.h"
+#include "../../move/movegen.h"
+#include "../../zobrist/zobrist.h"
+
+// ==========================================
+//  Perft: contagem de nós para validar o gerador
+// ==========================================
+// Uso:
+//   perft                                   -> roda as posições padrão e confere as contagens
+//   perft suite [depth]                     -> idem, limitando a profundidade máxima
+//   perft <depth> [fen|startpos] [opções]   -> perft de uma posição
+//
+// Opções:
+//   --divide        Imprime a contagem de cada lance da raiz
+//   --hash <MB>     Tabela de perft (chave = hashKey + profundidade), 0 desliga
+//   --threads <N>   Divide os lances da raiz entre N threads
+//
+// Via Makefile: make debug-tool NAME=tests/perft ARGS="5 startpos --divide"
+
+// ==========================================
+//  Tabela de perft
+// ==========================================
+// Entrada sem lock: a chave é guardada com XOR dos dados, então uma escrita
+// concorrente rasgada simplesmente não bate na leitura (é tratada como miss).
+struct PerftEntry {
+    std::atomic<uint64_t> check;
+    std::atomic<uint64_t> data;   // nodes << 8 | depth
+};
+
+class PerftTable {
+public:
+    void resize(int mb) {
+        delete[] table;
+        table = nullptr;
+        mask = 0;
+        if (mb <= 0) return;
+
+        size_t count = 1;
+        while (count * 2 * sizeof(PerftEntry) <= size_t(mb) * 1024 * 1024) count *= 2;
+        table = new PerftEntry[count];
+        mask = count - 1;
+        for (size_t i = 0; i < count; ++i) {
+            table[i].check.store(0, std::memory_order_relaxed);
+            table[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~PerftTable() { delete[] table; }
+
+    bool enabled() const { return table != nullptr; }
+
+    bool probe(uint64_t key, int depth, uint64_t& nodes) const {
+        const PerftEntry& e = table[index(key, depth)];
+        uint64_t data = e.data.load(std::memory_order_relaxed);
+        uint64_t check = e.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key || int(data & 0xFF) != depth) return false;
+        nodes = data >> 8;
+        return true;
+    }
+
+    void store(uint64_t key, int depth, uint64_t nodes) {
+        PerftEntry& e = table[index(key, depth)];
+        uint64_t data = (nodes << 8) | uint64_t(depth);
+        e.data.store(data, std::memory_order_relaxed);
+        e.check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+private:
+    PerftEntry* table = nullptr;
+    size_t mask = 0;
+
+    // A profundidade entra no índice para que a mesma posição em plies diferentes não colida
+    size_t index(uint64_t key, int depth) const {
+        return size_t(key ^ (uint64_t(depth) * 0x9E3779B97F4A7C15ULL)) & mask;
+    }
+};
+
+static PerftTable perftTable;
+
+// ==========================================
+//  Perft com contagem em massa nas folhas
+// ==========================================
+// Os geradores são legais, então em depth 1 basta o tamanho da lista (bulk counting).
+static uint64_t perft(Board& board, int depth) {
+    uint64_t nodes = 0;
+    if (depth > 1 && perftTable.enabled() && perftTable.probe(board.hashKey, depth, nodes))
+        return nodes;
+
+    MoveList moves = MoveGen::generateMoves(board);
+    if (depth == 1) return moves.size();
+
+    for (const auto& m : moves) {
+        StateInfo st;
+        board.makeMove(m, st);
+        nodes += perft(board, depth - 1);
+        board.unmakeMove(m, st);
+    }
+
+    if (perftTable.enabled())
+        perftTable.store(board.hashKey, depth, nodes);
+
+    return nodes;
+}
+
+/**
+ * @brief Divide os lances da raiz entre as threads. Cada thread pega o próximo
+ * lance livre numa fila atômica e trabalha numa cópia própria do tabuleiro.
+ * @return Contagem de cada lance da raiz, na ordem do gerador
+ */
+static std::vector<uint64_t> perftRoot(const Board& root, const MoveList& moves, int depth, int threads) {
+    std::vector<uint64_t> counts(moves.size(), 0);
+    if (depth <= 1) {
+        for (auto& c : counts) c = 1;
+        return counts;
+    }
+
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        Board board = root;
+        int i;
+        while ((i = next.fetch_add(1)) < moves.size()) {
+            StateInfo st;
+            board.makeMove(moves[i], st);
+            counts[i] = perft(board, depth - 1);
+            board.unmakeMove(moves[i], st);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    return counts;
+}
+
+struct PerftResult {
+    uint64_t nodes;
+    double seconds;
+};
+
+static PerftResult runPerft(const Board& board, int depth, int threads, bool divide) {
+    auto start = std::chrono::steady_clock::now();
+
+    MoveList moves = MoveGen::generateMoves(board);
+    std::vector<uint64_t> counts = perftRoot(board, moves, depth, threads);
+
+    auto end = std::chrono::steady_clock::now();
+
+    uint64_t total = 0;
+    for (int i = 0; i < moves.size(); ++i) {
+        total += counts[i];
+        if (divide)
+            std::cout << moveToUCI(moves[i]) << ": " << counts[i] << "\n";
+    }
+    if (divide) std::cout << "\nLances: " << moves.size() << "\n";
+
+    return { total, std::chrono::duration<double>(end - start).count() };
+}
+
+static double mnps(const PerftResult& r) {
+    return r.seconds > 0 ? (r.nodes / r.seconds) / 1e6 : 0.0;
+}
+
+// ==========================================
+//  Posições padrão (chessprogramming.org/Perft_Results)
+// ==========================================
+struct PerftPosition {
+    const char* name;
+    const char* fen;
+    std::vector<uint64_t> expected;  // expected[d-1] = perft(d)
+    int defaultDepth;
+};
+
+static const PerftPosition POSITIONS[] = {
+    { "startpos",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      { 20, 400, 8902, 197281, 4865609, 119060324 }, 5 },
+    { "kiwipete",
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      { 48, 2039, 97862, 4085603, 193690690 }, 4 },
+    { "position 3",
+      "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+      { 14, 191, 2812, 43238, 674624, 11030083, 178633661 }, 5 },
+    { "position 4",
+      "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+      { 6, 264, 9467, 422333, 15833292 }, 4 },
+    { "position 5",
+      "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+      { 44, 1486, 62379, 2103487, 89941194 }, 4 },
+    { "position 6",
+      "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+      { 46, 2079, 89890, 3894594, 164075551 }, 4 },
+};
+
+static bool runSuite(int maxDepth, int threads) {
+    bool allOk = true;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0;
+
+    // setw conta bytes: os acentos ocupam 2 bytes em UTF-8
+    std::cout << std::left << std::setw(14) << "Posição" << std::setw(7) << "Depth"
+              << std::setw(15) << "Nós" << std::setw(10) << "Mnps" << "Status\n";
+
+    for (const auto& pos : POSITIONS) {
+        int depth = pos.defaultDepth;
+        if (maxDepth > 0) depth = std::min<int>(maxDepth, pos.expected.size());
+
+        Board board = Board::fromFEN(pos.fen);
+        PerftResult r = runPerft(board, depth, threads, false);
+        bool ok = (r.nodes == pos.expected[depth - 1]);
+        allOk &= ok;
+        totalNodes += r.nodes;
+        totalSeconds += r.seconds;
+
+        std::cout << std::left << std::setw(12) << pos.name << std::setw(7) << depth
+                  << std::setw(14) << r.nodes << std::setw(10) << std::fixed << std::setprecision(2) << mnps(r)
+                  << (ok ? "OK" : "FAIL (esperado " + std::to_string(pos.expected[depth - 1]) + ")") << "\n";
+    }
+
+    std::cout << "\nTotal: " << totalNodes << " nós em " << std::setprecision(3) << totalSeconds
+              << " s (" << std::setprecision(2) << mnps({ totalNodes, totalSeconds }) << " Mnps)\n";
+    std::cout << (allOk ? "Todas as contagens conferem\n" : "Há contagens erradas!\n");
+    return allOk;
+}
+
+int main(int argc, char* argv[]) {
+    Zobrist::init();
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    bool divide = false;
+    int hashMb = 0;
+    int threads = 1;
+    std::vector<std::string> positional;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--divide") divide = true;
+        else if (args[i] == "--hash" && i + 1 < args.size()) hashMb = std::atoi(args[++i].c_str());
+        else if (args[i] == "--threads" && i + 1 < args.size()) threads = std::max(1, std::atoi(args[++i].c_str()));
+        else positional.push_back(args[i]);
+    }
+
+    perftTable.resize(hashMb);
+
+    if (positional.empty() || positional[0] == "suite") {
+        int maxDepth = positional.size() > 1 ? std::atoi(positional[1].c_str()) : 0;
+        return runSuite(maxDepth, threads) ? 0 : 1;
+    }
+
+    int depth = std::atoi(positional[0].c_str());
+    if (depth < 1) {
+        std::cerr << "Profundidade inválida: " << positional[0] << "\n";
+        return 1;
+    }
+
+    std::string fen = POSITIONS[0].fen;
+    if (positional.size() > 1 && positional[1] != "startpos") {
+        // Permite passar o FEN sem aspas (partes separadas em vários argumentos)
+        fen.clear();
+        for (size_t i = 1; i < positional.size(); ++i) {
+            if (i > 1) fen += ' ';
+            fen += positional[i];
+        }
+    }
+
+    Board board = Board::fromFEN(fen.c_str());
+    PerftResult r = runPerft(board, depth, threads, divide);
+
+    std::cout << "\nNós: " << r.nodes << "\n";
+    std::cout << "Tempo: " << std::fixed << std::setprecision(3) << r.seconds << " s\n";
+    std::cout << "Mnps: " << std::setprecision(2) << mnps(r) << "\n";
+    return 0;
+}
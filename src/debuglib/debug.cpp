@@ -107,7 +107,7 @@ namespace Debug {
             std::cout << CYN << rank + 1 << "  " << RST;
             for (int file = 0; file < 8; ++file) {
                 int sq = rank * 8 + file;
-                if ((board.whiteAttacks >> sq) & 1) std::cout << GRN << "x " << RST;
+                if ((board.attacks(SIDE_WHITE) >> sq) & 1) std::cout << GRN << "x " << RST;
                 else std::cout << ". ";
             }
             std::cout << "\n";
@@ -119,7 +119,7 @@ namespace Debug {
             std::cout << CYN << rank + 1 << "  " << RST;
             for (int file = 0; file < 8; ++file) {
                 int sq = rank * 8 + file;
-                if ((board.blackAttacks >> sq) & 1) std::cout << RED << "x " << RST;
+                if ((board.attacks(SIDE_BLACK) >> sq) & 1) std::cout << RED << "x " << RST;
                 else std::cout << ". ";
             }
             std::cout << "\n";
@@ -134,9 +134,9 @@ namespace Debug {
         std::cout << files[m.from % 8] << ranks[m.from / 8]
                   << files[m.to % 8]   << ranks[m.to / 8];
                   
-        if (m.flags & CAPTURE) std::cout << " (capture)";
-        if (m.flags & KING_CASTLE) std::cout << " (O-O)";
-        if (m.flags & QUEEN_CASTLE) std::cout << " (O-O-O)";
+        if (m.flags() & CAPTURE) std::cout << " (capture)";
+        if (m.flags() & KING_CASTLE) std::cout << " (O-O)";
+        if (m.flags() & QUEEN_CASTLE) std::cout << " (O-O-O)";
         std::cout << "\n";
     }
 
@@ -155,30 +155,31 @@ namespace Debug {
         std::string s = sqToStr(m.from) + sqToStr(m.to);
 
         // Adiciona sufixo de promoção se houver
-        if (m.flags & PROMOTION) {
-            switch (m.promotion) {
+        if (m.flags() & PROMOTION) {
+            switch (m.promotion()) {
                 case WQUEEN: case BQUEEN: s += 'q'; break;
                 case WROOK:  case BROOK:  s += 'r'; break;
                 case WBISHOP:case BBISHOP:s += 'b'; break;
                 case WKNIGHT:case BKNIGHT:s += 'n'; break;
+                default: break;
             }
         }
 
-        // Formatação rica para debug: "e2e4 [Score: 9000] (CAP)"
+        // Formatação rica para debug: "e2e4(C)". O score fica na MoveList, não no lance
         std::string flags = "";
-        if (m.flags & CAPTURE) flags += "C";
-        if (m.flags & PROMOTION) flags += "P";
-        if (m.flags & EN_PASSANT) flags += "E";
-        if (m.flags & KING_CASTLE) flags += "K";
-        if (m.flags & QUEEN_CASTLE) flags += "Q";
+        if (m.flags() & CAPTURE) flags += "C";
+        if (m.flags() & PROMOTION) flags += "P";
+        if (m.flags() & EN_PASSANT) flags += "E";
+        if (m.flags() & KING_CASTLE) flags += "K";
+        if (m.flags() & QUEEN_CASTLE) flags += "Q";
         
-        std::string debugStr = s + " [" + std::to_string(m.score) + "]";
+        std::string debugStr = s;
         if (!flags.empty()) debugStr += "(" + flags + ")";
 
         return debugStr;
     }
 
-    void printMoveList(const std::vector<Move>& moves, const std::string& title) {
+    void printMoveList(const MoveList& moves, const std::string& title) {
         Debug::cout << "=== " << title << " (" << moves.size() << ") ===\n";
         
         if (moves.empty()) {
@@ -189,8 +190,9 @@ namespace Debug {
         // Imprime em colunas ou linha a linha
         int idx = 0;
         for (const auto& m : moves) {
+            std::string entry = moveDebugString(m) + " [" + std::to_string(moves.score(idx)) + "]";
             Debug::cout << std::setw(2) << idx++ << ": " 
-                        << std::left << std::setw(20) << moveDebugString(m);
+                        << std::left << std::setw(20) << entry;
             
             // Quebra linha a cada 3 movimentos para não poluir
             if (idx % 3 == 0) Debug::cout << "\n";
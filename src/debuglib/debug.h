@@ -1,7 +1,6 @@
 #pragma once
 #include <string>
 #include "../board/board.h"
-#include <vector>
 
 #ifdef DEBUG
 
@@ -11,7 +10,8 @@
 namespace Debug {
     
     // ============ STREAM ==============
-    inline std::ostream& cout = std::cout;
+    // stderr: a saída padrão é do protocolo (UCI) e não pode receber texto de debug
+    inline std::ostream& cout = std::cerr;
     
 
     // ============== PRINT INFO API ================================
@@ -73,7 +73,7 @@ namespace Debug {
     /**
      * @brief Imprime um vetor de movimentos 
      */
-    void printMoveList(const std::vector<Move>& moves, const std::string& title = "Move List");
+    void printMoveList(const MoveList& moves, const std::string& title = "Move List");
 
     /**
      * @brief Imprime a tabela de Killer Moves.
@@ -91,7 +91,7 @@ namespace Debug {
     inline void printBoard(const Board&) {}
     inline void printAttackMaps(const Board&) {}
     inline void printMove(const Move&) {}
-    inline void printMoveList(const std::vector<Move>&, const std::string& = "") {}
+    inline void printMoveList(const MoveList&, const std::string& = "") {}
     inline void printKillerTable(const Move[][2], int) {}    
 
     struct NullStream {
@@ -2,73 +2,71 @@
 
 inline int gamePhase(const Board& b) {
     int phase = 0;
-    phase += __builtin_popcountll(b.whiteQueens  | b.blackQueens ) * 4;
-    phase += __builtin_popcountll(b.whiteRooks   | b.blackRooks  ) * 2;
-    phase += __builtin_popcountll(b.whiteBishops | b.blackBishops) * 1;
-    phase += __builtin_popcountll(b.whiteKnights | b.blackKnights) * 1;
+    phase += __builtin_popcountll(b.piecesByType(QUEEN) ) * 4;
+    phase += __builtin_popcountll(b.piecesByType(ROOK)  ) * 2;
+    phase += __builtin_popcountll(b.piecesByType(BISHOP)) * 1;
+    phase += __builtin_popcountll(b.piecesByType(KNIGHT)) * 1;
     if (phase > 24) phase = 24;
     return phase;   // 24 = MG puro, 0 = EG puro
 }
 
-inline int pstScore(uint64_t bb, const int* mg, const int* eg,
-                    int mgW, int egW, bool isWhite)
+// Espelha verticalmente para as pretas (rank 0 vira rank 7), resolvido em compilação
+template<Side S>
+inline int pstScore(uint64_t bb, const int* mg, const int* eg, int mgW, int egW)
 {
     int sMG = 0, sEG = 0;
     while (bb) {
         int sq = __builtin_ctzll(bb);
         bb &= bb - 1;
-        // Espelha verticalmente para as pretas (rank 0 vira rank 7)
-        int idx = isWhite ? sq : sq ^ 56;
+        constexpr int flip = (S == SIDE_WHITE) ? 0 : 56;
+        int idx = sq ^ flip;
         sMG += mg[idx];
         sEG += eg[idx];
     }
     return sMG * mgW + sEG * egW;
 }
 
-int Eval::evaluate(const Board& board) {
+template<Side S>
+inline int materialScore(const Board& b) {
+    return __builtin_popcountll(b.pieceBB(makePiece(S, PAWN)))   * P_VAL
+         + __builtin_popcountll(b.pieceBB(makePiece(S, KNIGHT))) * N_VAL
+         + __builtin_popcountll(b.pieceBB(makePiece(S, BISHOP))) * B_VAL
+         + __builtin_popcountll(b.pieceBB(makePiece(S, ROOK)))   * R_VAL
+         + __builtin_popcountll(b.pieceBB(makePiece(S, QUEEN)))  * Q_VAL;
+}
 
-    int mgPhase = gamePhase(board);
-    int egPhase = 24 - mgPhase;
+// PST interpolado de um lado. Este valor vem escalado por 24
+template<Side S>
+inline int pstSideScore(const Board& b, int mgPhase, int egPhase) {
+    return pstScore<S>(b.pieceBB(makePiece(S, PAWN)),   PST_P_MG, PST_P_EG, mgPhase, egPhase)
+         + pstScore<S>(b.pieceBB(makePiece(S, KNIGHT)), PST_N_MG, PST_N_EG, mgPhase, egPhase)
+         + pstScore<S>(b.pieceBB(makePiece(S, BISHOP)), PST_B_MG, PST_B_EG, mgPhase, egPhase)
+         + pstScore<S>(b.pieceBB(makePiece(S, ROOK)),   PST_R_MG, PST_R_EG, mgPhase, egPhase)
+         + pstScore<S>(b.pieceBB(makePiece(S, QUEEN)),  PST_Q_MG, PST_Q_EG, mgPhase, egPhase)
+         + pstScore<S>(b.pieceBB(makePiece(S, KING)),   PST_K_MG, PST_K_EG, mgPhase, egPhase);
+}
 
-    int scoreMat = 0;
+/**
+ * @brief Avaliação do ponto de vista de 'Us', especializada em compilação
+ */
+template<Side Us>
+static int evaluateFor(const Board& board) {
+    constexpr Side Them = ~Us;
 
-    scoreMat += __builtin_popcountll(board.whitePawns)   * P_VAL;
-    scoreMat += __builtin_popcountll(board.whiteKnights) * N_VAL;
-    scoreMat += __builtin_popcountll(board.whiteBishops) * B_VAL;
-    scoreMat += __builtin_popcountll(board.whiteRooks)   * R_VAL;
-    scoreMat += __builtin_popcountll(board.whiteQueens)  * Q_VAL;
+    int mgPhase = gamePhase(board);
+    int egPhase = 24 - mgPhase;
 
-    scoreMat -= __builtin_popcountll(board.blackPawns)   * P_VAL;
-    scoreMat -= __builtin_popcountll(board.blackKnights) * N_VAL;
-    scoreMat -= __builtin_popcountll(board.blackBishops) * B_VAL;
-    scoreMat -= __builtin_popcountll(board.blackRooks)   * R_VAL;
-    scoreMat -= __builtin_popcountll(board.blackQueens)  * Q_VAL;
+    // 1. Material
+    int scoreMat = materialScore<Us>(board) - materialScore<Them>(board);
 
     // 2. PST Interpolado
-    // Este valor virá escalado por 24
-    int scorePST = 0;
+    int scorePST = pstSideScore<Us>(board, mgPhase, egPhase) - pstSideScore<Them>(board, mgPhase, egPhase);
 
-    scorePST += pstScore(board.whitePawns, PST_P_MG, PST_P_EG, mgPhase, egPhase, true);
-    scorePST -= pstScore(board.blackPawns, PST_P_MG, PST_P_EG, mgPhase, egPhase, false);
-    
-    scorePST += pstScore(board.whiteKnights, PST_N_MG, PST_N_EG, mgPhase, egPhase, true);
-    scorePST -= pstScore(board.blackKnights, PST_N_MG, PST_N_EG, mgPhase, egPhase, false);
-    
-    scorePST += pstScore(board.whiteBishops, PST_B_MG, PST_B_EG, mgPhase, egPhase, true);
-    scorePST -= pstScore(board.blackBishops, PST_B_MG, PST_B_EG, mgPhase, egPhase, false);
-    
-    scorePST += pstScore(board.whiteRooks, PST_R_MG, PST_R_EG, mgPhase, egPhase, true);
-    scorePST -= pstScore(board.blackRooks, PST_R_MG, PST_R_EG, mgPhase, egPhase, false);
-    
-    scorePST += pstScore(board.whiteQueens, PST_Q_MG, PST_Q_EG, mgPhase, egPhase, true);
-    scorePST -= pstScore(board.blackQueens, PST_Q_MG, PST_Q_EG, mgPhase, egPhase, false);
-    
-    scorePST += pstScore(board.whiteKing, PST_K_MG, PST_K_EG, mgPhase, egPhase, true);
-    scorePST -= pstScore(board.blackKing, PST_K_MG, PST_K_EG, mgPhase, egPhase, false);
-    
     // Normalização
-    int finalScore = scoreMat + (scorePST / 24);
+    return scoreMat + (scorePST / 24);
+}
 
+int Eval::evaluate(const Board& board) {
     // Retorna do ponto de vista do lado a jogar
-    return board.whiteToMove ? finalScore : -finalScore;
+    return board.whiteToMove ? evaluateFor<SIDE_WHITE>(board) : evaluateFor<SIDE_BLACK>(board);
 }
@@ -30,6 +30,9 @@ ChessGUI::ChessGUI() {
     
     // TT de 64MB
     TT.resize(64);
+
+    // Lazy SMP: uma thread de busca por núcleo
+    searcher.setThreads(std::max(1u, std::thread::hardware_concurrency()));
     board = Board::fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
     board.updateAttackBoards();
     legalMoves = MoveGen::generateMoves(board);
@@ -42,6 +45,9 @@ ChessGUI::ChessGUI() {
 }
 
 ChessGUI::~ChessGUI() {
+    // Se a engine ainda estiver pensando, interrompe e espera a thread largar o objeto
+    stopEngineThink();
+
     UnloadTexture(pieceTextures);
     UnloadTexture(enginePfp);
     UnloadTexture(userPfp);
@@ -102,6 +108,9 @@ void ChessGUI::loadPlayerConfig() {
 }
 
 void ChessGUI::resetGame() {
+    // A busca do jogo anterior não pode terminar dentro do novo
+    stopEngineThink();
+
     board = Board::fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
     board.updateAttackBoards();
     legalMoves = MoveGen::generateMoves(board);
@@ -116,7 +125,6 @@ void ChessGUI::resetGame() {
     gameReason = REASON_NONE;
     timerActive = false;
     gameOverTimer = 0.0f;
-    fiftyMoveCounter = 0;
     positionHistory.clear();
     
 
@@ -133,6 +141,7 @@ void ChessGUI::resetGame() {
     // Reseta flags da thread
     isEngineThinking = false;
     engineMoveReady = false;
+    engineLine.clear();
 
     // Configura os Players usando os dados carregados em loadAssets
     if (userIsWhite) {
@@ -266,18 +275,42 @@ void ChessGUI::run() {
 void ChessGUI::startEngineThink() {
     if (isEngineThinking) return;
 
+    // A busca anterior já terminou (isEngineThinking == false), só falta o join
+    if (engineThread.joinable()) engineThread.join();
+
     isEngineThinking = true;
 
-    std::thread searchThread([this]() {
+    // Posições anteriores do jogo, para a busca reconhecer repetições
+    std::vector<uint64_t> gameKeys;
+    for (size_t i = 0; i + 1 < stateHistory.size(); ++i) {
+        gameKeys.push_back(stateHistory[i].hashKey);
+    }
+    searcher.setGameHistory(std::move(gameKeys));
+
+    // A thread busca numa cópia: a main thread pode mexer em 'board' enquanto isso
+    engineThread = std::thread([this, root = board]() {
         
-        Move best = Search::searchBestMove(board, 6);
+        // Tempo fixo por lance: a latência não depende mais da posição
+        SearchLimits limits;
+        limits.movetime = ENGINE_MOVE_TIME_MS;
+        Move best = searcher.searchBestMove(root, limits);
         
         this->computedMove = best;
-        this->engineMoveReady = true;     // Avisa a main thread
+        this->computedResult = searcher.lastResult();
+        this->engineMoveReady.store(true, std::memory_order_release); // Avisa a main thread
         this->isEngineThinking = false;   // Libera a flag
     });
+}
 
-    searchThread.detach();
+void ChessGUI::stopEngineThink() {
+    if (!engineThread.joinable()) return;
+
+    // Repete o stop: um pedido feito antes de a busca começar é apagado por ela ao iniciar
+    while (isEngineThinking) {
+        searcher.stop();
+        std::this_thread::yield();
+    }
+    engineThread.join();
 }
 
 void ChessGUI::updateLogic() {
@@ -328,9 +361,10 @@ void ChessGUI::updateLogic() {
     // =========================================================
 
     // Aplica movimento da engine se estiver pronto
-    if (engineMoveReady) {
-        engineMoveReady = false;
+    if (engineMoveReady.load(std::memory_order_acquire)) {
+        engineMoveReady.store(false, std::memory_order_relaxed);
         if (computedMove.from != computedMove.to) {
+            updateEngineLine(); // Antes do lance: a PV parte da posição atual
             performMove(computedMove);
         }
     }
@@ -375,8 +409,8 @@ void ChessGUI::updateLogic() {
                 }
             }
 
+            // Numa promoção o gerador emite a dama primeiro, então o lance encontrado já promove a dama
             if (found) {
-                if (move.flags & PROMOTION && move.promotion == EMPTY) move.promotion = WQUEEN;
                 performMove(move);
             }
         }
@@ -446,18 +480,8 @@ void ChessGUI::setVisualPly(int targetPly) {
 
 void ChessGUI::performMove(Move m) {
     
-    // Atualiza Regra 50 lances  
-    
+    // A regra dos 50 lances é contada pelo próprio Board (halfmoveClock)
     Piece p = board.pieceAt(m.from);
-    
-    bool isPawn = (p == WPAWN || p == BPAWN);
-    bool isCapture = m.flags & CAPTURE || m.flags & EN_PASSANT;
-
-    if (isPawn || isCapture) {
-        fiftyMoveCounter = 0;
-    } else {
-        fiftyMoveCounter++;
-    }
 
     // Gera notação e Atualiza Histórico de Texto
     std::string san = moveToSAN(m, board);
@@ -475,7 +499,7 @@ void ChessGUI::performMove(Move m) {
     flatMoveHistory.push_back(m);
 
     // Configura Animação Visual
-    if (m.flags & PROMOTION) p = (Piece)m.promotion;
+    if (m.flags() & PROMOTION) p = m.promotion();
 
     Vector2 startPos = getSquarePos(m.from);
     Vector2 endPos   = getSquarePos(m.to);
@@ -489,8 +513,8 @@ void ChessGUI::performMove(Move m) {
     animations.push_back(anim);
     
     // Animação da Torre (Roque)
-    if (m.flags & KING_CASTLE || m.flags & QUEEN_CASTLE) {
-        bool kingside = (m.flags & KING_CASTLE);
+    if (m.flags() & KING_CASTLE || m.flags() & QUEEN_CASTLE) {
+        bool kingside = (m.flags() & KING_CASTLE);
         // Lógica para achar a torre correta
         int rFrom = kingside ? (board.whiteToMove ? 7 : 63) : (board.whiteToMove ? 0 : 56);
         int rTo   = kingside ? (board.whiteToMove ? 5 : 61) : (board.whiteToMove ? 3 : 59);
@@ -603,6 +627,10 @@ void ChessGUI::drawPanels() {
         // Texto
         DrawText(bottomPlayer->name.c_str(), textX, bottomY + 10, 24, WHITE);
         DrawText(bottomPlayer->rating.c_str(), textX, bottomY + 40, 20, LIGHTGRAY);
+
+        // Linha da engine no espaço entre os dois jogadores
+        float lineY = topContentY + avatarSize + padding;
+        drawEngineLine({ leftPanelRect.x + padding, lineY, leftPanelRect.width - padding * 2, bottomY - padding - lineY });
     }
 
     // ---------------------------------------------------------
@@ -768,6 +796,73 @@ void ChessGUI::drawPanels() {
     }
 }
 
+void ChessGUI::updateEngineLine() {
+    const SearchContext::Result& r = computedResult;
+    if (r.pvLength == 0) return;
+
+    // Score do ponto de vista das brancas, como nas GUIs de análise
+    int score = board.whiteToMove ? r.score : -r.score;
+    std::string line;
+    if (std::abs(r.score) >= MATE_SCORE - MAX_PLY) {
+        int mateIn = (MATE_SCORE - std::abs(r.score) + 1) / 2;
+        line = std::string(score > 0 ? "#" : "#-") + std::to_string(mateIn);
+    } else {
+        line = TextFormat("%+.2f", score / 100.0);
+    }
+    line += TextFormat("  (depth %d)\n", r.depth);
+
+    // PV em SAN, numerada como na lista de lances
+    Board b = board;
+    int moveNumber = 1 + (int)flatMoveHistory.size() / 2;
+    for (int i = 0; i < r.pvLength; ++i) {
+        if (b.whiteToMove) line += std::to_string(moveNumber) + ". ";
+        else if (i == 0) line += std::to_string(moveNumber) + "... ";
+
+        line += moveToSAN(r.pv[i], b) + " ";
+        if (!b.whiteToMove) ++moveNumber;
+        b = b.applyMove(r.pv[i]);
+    }
+    engineLine = line;
+}
+
+void ChessGUI::drawEngineLine(Rectangle area) {
+    if (engineLine.empty() || area.width <= 0 || area.height <= 0) return;
+
+    const int fontSize = 18;
+    const float lineHeight = fontSize + 6;
+    float y = area.y;
+
+    // Quebra por palavras para caber na largura do painel
+    std::string current;
+    auto flush = [&]() {
+        if (!current.empty() && y + lineHeight <= area.y + area.height) {
+            DrawText(current.c_str(), area.x, y, fontSize, LIGHTGRAY);
+        }
+        current.clear();
+        y += lineHeight;
+    };
+
+    size_t pos = 0;
+    while (pos < engineLine.size()) {
+        size_t end = engineLine.find_first_of(" \n", pos);
+        if (end == std::string::npos) end = engineLine.size();
+        std::string word = engineLine.substr(pos, end - pos);
+
+        if (!word.empty()) {
+            std::string candidate = current.empty() ? word : current + " " + word;
+            if (!current.empty() && MeasureText(candidate.c_str(), fontSize) > area.width) {
+                flush();
+                candidate = word;
+            }
+            current = candidate;
+        }
+
+        if (end < engineLine.size() && engineLine[end] == '\n') flush();
+        pos = end + 1;
+    }
+    flush();
+}
+
 void ChessGUI::drawControlButtons(float x, float y, float w) {
     float btnW = w / 4.0f;
     float btnH = 50;
@@ -1277,7 +1372,7 @@ std::string ChessGUI::generateFEN(bool full) {
 
     // 5. Contadores (Só para Save/Copy)
     // Halfmove (50 regras)
-    fen += " " + std::to_string(fiftyMoveCounter);
+    fen += " " + std::to_string(board.halfmoveClock);
     
     // Fullmove (Número da jogada)
     int fullMove = 1 + (flatMoveHistory.size() / 2);
@@ -1339,16 +1434,16 @@ std::string ChessGUI::generatePGN() {
 }
 
 bool ChessGUI::checkInsufficientMaterial() {
-    uint64_t heavyPieces = board.whitePawns | board.blackPawns | 
-                           board.whiteRooks | board.blackRooks | 
-                           board.whiteQueens | board.blackQueens;
+    uint64_t heavyPieces = board.piecesByType(PAWN) |
+                           board.piecesByType(ROOK) |
+                           board.piecesByType(QUEEN);
                            
     if (std::popcount(heavyPieces) > 0) return false;
 
-    int wKnight = std::popcount(board.whiteKnights);
-    int wBishop = std::popcount(board.whiteBishops);
-    int bKnight = std::popcount(board.blackKnights);
-    int bBishop = std::popcount(board.blackBishops);
+    int wKnight = std::popcount(board.pieces[SIDE_WHITE][KNIGHT]);
+    int wBishop = std::popcount(board.pieces[SIDE_WHITE][BISHOP]);
+    int bKnight = std::popcount(board.pieces[SIDE_BLACK][KNIGHT]);
+    int bBishop = std::popcount(board.pieces[SIDE_BLACK][BISHOP]);
 
     int wMinor = wKnight + wBishop;
     int bMinor = bKnight + bBishop;
@@ -1394,8 +1489,7 @@ void ChessGUI::checkGameOver() {
         isGameOver = true;
         timerActive = true;
 
-        bool inCheck = board.whiteToMove ? (board.whiteKing & board.blackAttacks) 
-                                     : (board.blackKing & board.whiteAttacks);
+        bool inCheck = board.inCheck();
 
         if (inCheck) {
             gameReason = REASON_CHECKMATE;
@@ -1406,7 +1500,7 @@ void ChessGUI::checkGameOver() {
         }
     }
 
-    if (fiftyMoveCounter >= 100) {
+    if (board.halfmoveClock >= 100) {
         isGameOver = true;
         gameResult = RESULT_DRAW;
         gameReason = REASON_50_MOVE_RULE;
@@ -1444,12 +1538,13 @@ void ChessGUI::saveGameToFile() {
         outFile << "\n{RawMoves:";
         for (const auto& m : flatMoveHistory) {
             std::string s = squareToAlgebraic(m.from) + squareToAlgebraic(m.to);
-            if (m.flags & PROMOTION) {
-                switch(m.promotion) {
+            if (m.flags() & PROMOTION) {
+                switch(m.promotion()) {
                     case WQUEEN: case BQUEEN: s += "q"; break;
                     case WROOK: case BROOK:   s += "r"; break;
                     case WBISHOP: case BBISHOP: s += "b"; break;
                     case WKNIGHT: case BKNIGHT: s += "n"; break;
+                    default: break;
                 }
             }
             outFile << " " << s;
@@ -1738,7 +1833,7 @@ void ChessGUI::loadGameFromFile(const SavedGameEntry& entry) {
                         if (pChar == 'b') pPromo = w ? WBISHOP : BBISHOP;
                         if (pChar == 'n') pPromo = w ? WKNIGHT : BKNIGHT;
                         
-                        if (m.promotion != pPromo) continue;
+                        if (m.promotion() != pPromo) continue;
                     }
                     
                     moveToPlay = m;
@@ -3,6 +3,7 @@
 #include "raymath.h"
 #include "../board/board.h"
 #include "../move/move.h"
+#include "../search/search.h"
 #include <fstream>
 #include <vector>
 #include <list>
@@ -90,7 +91,7 @@ private:
 
     // Core
     Board board;
-    std::vector<Move> legalMoves;
+    MoveList legalMoves;
     Texture2D pieceTextures;
     Texture2D defaultAvatar;
     
@@ -128,10 +129,24 @@ private:
     void resetGame();
     
     // Controle de thread da engine
+    static constexpr int ENGINE_MOVE_TIME_MS = 1000;
+    Searcher searcher{TT};
     std::atomic<bool> isEngineThinking = false;
-    bool engineMoveReady = false; 
+    // Publicado pela thread da engine com release depois de computedMove/computedResult;
+    // a main thread lê com acquire antes de tocar neles
+    std::atomic<bool> engineMoveReady = false;
     Move computedMove = {};
+    SearchContext::Result computedResult;
+
+    // Thread da busca em andamento. Busca numa cópia do tabuleiro e é sempre
+    // encerrada com stopEngineThink() antes de o estado do jogo mudar
+    std::thread engineThread;
+
+    // Linha esperada pela engine (score + PV em SAN), mostrada no painel esquerdo
+    std::string engineLine;
+    void updateEngineLine();
     void startEngineThink();
+    void stopEngineThink();
 
     // Logic Steps
     void updateLogic(); 
@@ -171,13 +186,13 @@ private:
 
     // Helper de UI para desenhar ícones de controle
     void drawControlButtons(float x, float y, float w);
+    void drawEngineLine(Rectangle area);
 
     // ---- FIM DE JOGO E REGRAS ----
     bool isGameOver = false;
     bool showGameOverPopup = false;
     GameResult gameResult = RESULT_NONE;
     GameReason gameReason = REASON_NONE;
-    int fiftyMoveCounter = 0;
     
     float gameOverTimer = 0.0f; // Delay para não tomar jumpscare no mate xd
     bool timerActive = false;
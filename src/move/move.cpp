@@ -2,7 +2,6 @@
 #include "../board/board.h"
 #include "movegen.h"
 #include <sstream>
-#include <vector>
 
 std::string moveToUCI(const Move& m) {
     std::stringstream ss;
@@ -12,12 +11,13 @@ std::string moveToUCI(const Move& m) {
     ss << files[m.from % 8] << ranks[m.from / 8];
     ss << files[m.to % 8] << ranks[m.to / 8];
 
-    if (m.flags & PROMOTION) {
-        switch (m.promotion) {
+    if (m.flags() & PROMOTION) {
+        switch (m.promotion()) {
             case WQUEEN: case BQUEEN: ss << "q"; break;
             case WROOK: case BROOK: ss << "r"; break;
             case WBISHOP: case BBISHOP: ss << "b"; break;
             case WKNIGHT: case BKNIGHT: ss << "n"; break;
+            default: break;
         }
     }
     return ss.str();
@@ -28,8 +28,8 @@ std::string moveToSAN(const Move& move, const Board& boardState) {
     san.reserve(8);
 
     // Castling
-    if (move.flags & KING_CASTLE)  return "O-O";
-    if (move.flags & QUEEN_CASTLE) return "O-O-O";
+    if (move.flags() & KING_CASTLE)  return "O-O";
+    if (move.flags() & QUEEN_CASTLE) return "O-O-O";
 
     Piece p = boardState.pieceAt(move.from);
     bool isPawn = (p == WPAWN || p == BPAWN);
@@ -53,7 +53,7 @@ std::string moveToSAN(const Move& move, const Board& boardState) {
         bool ambiguityRank = false;
         bool needsDisambiguation = false;
 
-        std::vector<Move> moves = MoveGen::generatePieceMoves(boardState, p);
+        MoveList moves = MoveGen::generatePieceMoves(boardState, p);
 
         for (const auto& otherM : moves) {
             if (otherM.from != move.from && otherM.to == move.to) {
@@ -88,7 +88,7 @@ std::string moveToSAN(const Move& move, const Board& boardState) {
     // -----------------------------
     bool isCapture =
         (boardState.pieceAt(move.to) != EMPTY) ||
-        (move.flags & EN_PASSANT);
+        (move.flags() & EN_PASSANT);
 
     if (isCapture) {
         if (isPawn)
@@ -105,9 +105,9 @@ std::string moveToSAN(const Move& move, const Board& boardState) {
     // -----------------------------
     // Promoção
     // -----------------------------
-    if (move.flags & PROMOTION) {
+    if (move.flags() & PROMOTION) {
         san.push_back('=');
-        switch (move.promotion) {
+        switch (move.promotion()) {
             case WQUEEN:
             case BQUEEN:  san.push_back('Q'); break;
             case WROOK:
@@ -116,6 +116,7 @@ std::string moveToSAN(const Move& move, const Board& boardState) {
             case BBISHOP: san.push_back('B'); break;
             case WKNIGHT:
             case BKNIGHT: san.push_back('N'); break;
+            default: break;
         }
     }
 
@@ -123,17 +124,10 @@ std::string moveToSAN(const Move& move, const Board& boardState) {
     // Xeque ou mate
     // -----------------------------
     Board nextBoard = boardState.applyMove(move);
-    nextBoard.updateAttackBoards();
 
-    bool enemyWhite = !boardState.whiteToMove;
-    uint64_t kingBB = enemyWhite ? nextBoard.whiteKing : nextBoard.blackKing;
-
-    bool inCheck = enemyWhite
-        ? (nextBoard.blackAttacks & kingBB)
-        : (nextBoard.whiteAttacks & kingBB);
-
-    if (inCheck) {
-        std::vector<Move> responses = MoveGen::generateCheckResponses(nextBoard);
+    // Depois do lance a vez é do adversário, então inCheck() olha para o rei dele
+    if (nextBoard.inCheck()) {
+        MoveList responses = MoveGen::generateCheckResponses(nextBoard);
         san.push_back(responses.empty() ? '#' : '+');
     }
 
@@ -1,6 +1,9 @@
 #pragma once
 #include <cstdint>
 #include <string>
+#include <bit>
+#include <utility>
+#include "../board/piece.h"
 
 #define OFFSET 10000
 
@@ -14,24 +17,131 @@ enum MoveFlags : uint8_t {
     PROMOTION  = 1 << 5
 };
 
+// Tipo do lance em 4 bits (codificação do chessprogramming.org/Encoding_Moves).
+// O bit 2 marca captura e o bit 3 promoção; numa promoção os 2 bits baixos são a
+// peça (0 = cavalo .. 3 = dama), então "promoção com captura" também cabe nos 4 bits.
+enum MoveKind : uint8_t {
+    KIND_QUIET         = 0,
+    KIND_DOUBLE_PUSH   = 1,
+    KIND_KING_CASTLE   = 2,
+    KIND_QUEEN_CASTLE  = 3,
+    KIND_CAPTURE       = 4,
+    KIND_EN_PASSANT    = 5,
+    KIND_PROMOTION     = 8,  // + (PieceType - KNIGHT)
+    KIND_PROMO_CAPTURE = 12  // + (PieceType - KNIGHT)
+};
+
+// MoveFlags equivalentes a cada MoveKind (6 e 7 não são usados)
+static constexpr uint8_t KIND_FLAGS[16] = {
+    QUIET, DOUBLE_PAWN_PUSH, KING_CASTLE, QUEEN_CASTLE,
+    CAPTURE, CAPTURE | EN_PASSANT, QUIET, QUIET,
+    PROMOTION, PROMOTION, PROMOTION, PROMOTION,
+    PROMOTION | CAPTURE, PROMOTION | CAPTURE, PROMOTION | CAPTURE, PROMOTION | CAPTURE
+};
+
+/**
+ * @brief Tipo da promoção para a peça 't' (KNIGHT..QUEEN), com ou sem captura
+ */
+constexpr MoveKind promotionKind(PieceType t, bool capture) {
+    return MoveKind((capture ? KIND_PROMO_CAPTURE : KIND_PROMOTION) + (t - KNIGHT));
+}
+
+/**
+ * @brief Lance em 16 bits: origem (6), destino (6) e tipo (4).
+ * O lance é completo, então o mesmo valor é guardado na TT, nos killers e
+ * nas listas, sem perder as flags no caminho. O score de ordenação fica
+ * fora do lance, num array paralelo da MoveList.
+ */
 struct Move {
-    uint8_t from;        // 0..63
-    uint8_t to;          // 0..63
-    uint8_t promotion;  // Piece (só usado se PROMOTION)
-    uint8_t flags;      // MoveFlags
-    int score;          // Pontuação MVV-LVA
-    
-    // Ignora flags e score
+    uint16_t from : 6;  // 0..63
+    uint16_t to   : 6;  // 0..63
+    uint16_t kind : 4;  // MoveKind
+
+    Move() = default;   // Move{} é o lance nulo (tudo zero)
+    constexpr Move(int f, int t, MoveKind k = KIND_QUIET) : from(f), to(t), kind(k) {}
+
+    // Flags no formato antigo (bitmask de MoveFlags), derivadas do tipo
+    inline uint8_t flags() const { return KIND_FLAGS[kind]; }
+
+    // Peça da promoção, sem cor (só faz sentido se flags() & PROMOTION)
+    inline PieceType promotionType() const { return PieceType(KNIGHT + (kind & 3)); }
+
+    // Peça da promoção com cor (a cor sai da fileira de destino), EMPTY se não for promoção
+    inline Piece promotion() const {
+        if (!(kind & KIND_PROMOTION)) return EMPTY;
+        return makePiece(to >= 56 ? SIDE_WHITE : SIDE_BLACK, promotionType());
+    }
+
+    // Os 16 bits crus, para comparar e guardar
+    inline uint16_t raw() const { return std::bit_cast<uint16_t>(*this); }
+
     bool operator==(const Move& other) const {
-        return from == other.from && 
-               to == other.to && 
-               promotion == other.promotion;
+        return raw() == other.raw();
     }
 
     bool operator!=(const Move& other) const {
         return !(*this == other);
     }
+};
+
+static_assert(sizeof(Move) == 2, "Move deve ocupar 16 bits");
+
+// Número máximo de lances legais numa posição (o recorde conhecido é 218)
+constexpr int MAX_MOVES = 256;
 
+/**
+ * @brief Lista de lances com capacidade fixa e armazenamento inline (na pilha).
+ * Substitui std::vector<Move> nos geradores para que a busca não toque no heap.
+ * Os scores de ordenação ficam num array paralelo: quem só percorre os lances
+ * lê apenas os 2 bytes de cada um.
+ */
+struct MoveList {
+    Move moves[MAX_MOVES];
+    int scores[MAX_MOVES];
+    int count = 0;
+
+    inline void push_back(const Move& m, int score = 0) {
+        moves[count] = m;
+        scores[count++] = score;
+    }
+    inline void clear() { count = 0; }
+
+    inline int size() const { return count; }
+    inline bool empty() const { return count == 0; }
+
+    inline Move& operator[](int i) { return moves[i]; }
+    inline const Move& operator[](int i) const { return moves[i]; }
+
+    inline int& score(int i) { return scores[i]; }
+    inline int score(int i) const { return scores[i]; }
+
+    // Troca dois lances junto com os seus scores
+    inline void swap(int i, int j) {
+        std::swap(moves[i], moves[j]);
+        std::swap(scores[i], scores[j]);
+    }
+
+    /**
+     * @brief Ordena por score decrescente (insertion sort estável, as listas são curtas)
+     */
+    inline void sort() {
+        for (int i = 1; i < count; ++i) {
+            Move m = moves[i];
+            int s = scores[i];
+            int j = i - 1;
+            for (; j >= 0 && scores[j] < s; --j) {
+                moves[j + 1] = moves[j];
+                scores[j + 1] = scores[j];
+            }
+            moves[j + 1] = m;
+            scores[j + 1] = s;
+        }
+    }
+
+    inline Move* begin() { return moves; }
+    inline Move* end() { return moves + count; }
+    inline const Move* begin() const { return moves; }
+    inline const Move* end() const { return moves + count; }
 };
 
 static constexpr int MVV_LVA_VALUES[13] = {
@@ -50,35 +160,6 @@ static constexpr int MVV_LVA_VALUES[13] = {
     20000   // BKING
 };
 
-using PackedMove = uint16_t;
-
-// Compacta: Move (8 bytes) -> PackedMove (2 bytes)
-inline PackedMove packMove(const Move& m) {
-    // Pegamos os 6 bits de from, 6 bits de to, e 4 bits da peça de promoção
-    // O '& 0x3F' garante que só pegamos 6 bits (0-63)
-    // O '& 0xF' garante que só pegamos 4 bits (0-15)
-    return (m.from & 0x3F) | 
-           ((m.to & 0x3F) << 6) | 
-           ((m.promotion & 0xF) << 12);
-}
-
-// Descompacta: PackedMove (2 bytes) -> Move (8 bytes)
-// O lance descompactado é "cru". Ele perde as flags (Capture, Castle, etc).
-// Ele serve apenas para comparação (Matching).
-inline Move unpackMove(PackedMove pm) {
-    Move m;
-    m.from = pm & 0x3F;
-    m.to   = (pm >> 6) & 0x3F;
-    m.promotion = (pm >> 12) & 0xF;
-    
-    // Recuperação parcial de flags (apenas Promotion dá pra saber com certeza)
-    m.flags = (m.promotion != 0) ? PROMOTION : QUIET; 
-    
-    // Zera o resto (não sabemos se é captura ou castle só olhando os bits)
-    m.score = 0; 
-    return m;
-}
-
 struct Board;
 
 // Converte para notação simples (ex: "e2e4", "a7a8q")
@@ -2,8 +2,9 @@
 #include <iostream>
 
 // Calcula o score do movimento seguindo MVV-LVA
-static int scoreMove(const Board& board, int from, int to, uint8_t flags, uint8_t promotion) {
+static int scoreMove(const Board& board, int from, int to, MoveKind kind) {
     int score = 0;
+    uint8_t flags = KIND_FLAGS[kind];
 
     if (flags & CAPTURE) {
         int victim = board.pieceAt(to);
@@ -21,8 +22,9 @@ static int scoreMove(const Board& board, int from, int to, uint8_t flags, uint8_
     }
 
     if (flags & PROMOTION) {
-        // Promoção vale muito (geralmente vira Dama)
-        score += MVV_LVA_VALUES[promotion] + 1000;
+        // Promoção vale muito (geralmente vira Dama). O valor da peça não depende da cor
+        PieceType promoted = PieceType(KNIGHT + (kind & 3));
+        score += MVV_LVA_VALUES[makePiece(SIDE_WHITE, promoted)] + 1000;
     }
 
     return score;
@@ -31,45 +33,108 @@ static int scoreMove(const Board& board, int from, int to, uint8_t flags, uint8_
 // ------------------------------------------
 // Validador Normal (MoveGen::generateMoves)
 // ------------------------------------------
-static bool validator(const Board& board, std::vector<Move>& moves, int from, int to, uint8_t flags, uint8_t promotion = EMPTY) {
-    Move m;
-    m.from = from;
-    m.to = to;
-    m.flags = flags;
-    m.promotion = promotion;
-    
+// Os geradores já emitem apenas lances legais, então o validador só pontua e guarda.
+static bool validator(const Board& board, MoveList& moves, int from, int to, MoveKind kind) {
+    moves.push_back(Move(from, to, kind), scoreMove(board, from, to, kind));
+    return true;
+}
 
-    // Aplica o movimento num tabuleiro temporário
-    Board nextBoard = board.applyMove(m);
+// ------------------------------------------
+// Informações de legalidade do nó
+// ------------------------------------------
+template<Side Us>
+static MoveGen::LegalInfo computeLegalInfoFor(const Board& board) {
+    MoveGen::LegalInfo info;
+
+    constexpr Side Them = ~Us;
+    const uint64_t king = board.pieceBB(makePiece(Us, KING));
+
+    if (king == 0) { // Posições de teste sem rei
+        info.kingSq = -1;
+        info.checkers = 0;
+        info.pinned = 0;
+        info.checkMask = ~0ULL;
+        info.kingDanger = 0;
+        return info;
+    }
 
-    // Atualiza o mapa de ataques do novo tabuleiro
-    nextBoard.updateAttackBoards();
+    const int kingSq = __builtin_ctzll(king);
+    const uint64_t own = (Us == SIDE_WHITE) ? board.whitePieces() : board.blackPieces();
+    const uint64_t enemies = (Us == SIDE_WHITE) ? board.blackPieces() : board.whitePieces();
+    const uint64_t all = own | enemies;
 
-    // Verifica se o rei de quem acabou de mover (o "eu" do turno anterior) está em xeque
-    // Nota: applyMove inverte o turno (whiteToMove). 
-    // Se quem moveu foi BRANCO, agora é vez do PRETO. Checamos se o rei BRANCO está sob ataque do PRETO.
-    
-    bool moveWasByWhite = !nextBoard.whiteToMove; 
+    info.kingSq = kingSq;
+    info.checkers = board.attackersTo(kingSq, all) & enemies;
 
-    if (moveWasByWhite) {
-        // Se o rei branco colide com os ataques pretos -> Ilegal
-        if (nextBoard.whiteKing & nextBoard.blackAttacks) return false;
-    } else {
-        // Se o rei preto colide com os ataques brancos -> Ilegal
-        if (nextBoard.blackKing & nextBoard.whiteAttacks) return false;
+    // Sem xeque qualquer destino serve. Em xeque simples, só capturar o atacante
+    // ou bloquear o raio entre ele e o rei.
+    info.checkMask = ~0ULL;
+    if (info.checkers) {
+        int checkerSq = __builtin_ctzll(info.checkers);
+        info.checkMask = info.checkers | BETWEEN[kingSq][checkerSq];
     }
 
-    // Se passou no teste, adiciona à lista
-    m.score = scoreMove(board, from, to, flags, promotion);
-    moves.push_back(m);
-    return true;
+    // Cravadas: deslizantes inimigos alinhados com o rei com exatamente uma peça no meio
+    const uint64_t enemyQueens = board.pieceBB(makePiece(Them, QUEEN));
+    const uint64_t enemyDiag = board.pieceBB(makePiece(Them, BISHOP)) | enemyQueens;
+    const uint64_t enemyOrtho = board.pieceBB(makePiece(Them, ROOK)) | enemyQueens;
+
+    uint64_t snipers = (bishopAttacks(kingSq, 0) & enemyDiag) |
+                       (rookAttacks(kingSq, 0) & enemyOrtho);
+
+    info.pinned = 0;
+    while (snipers) {
+        int sniperSq = __builtin_ctzll(snipers);
+        snipers &= snipers - 1;
+
+        uint64_t between = BETWEEN[kingSq][sniperSq] & all;
+        if (between && !(between & (between - 1)))
+            info.pinned |= between & own;
+    }
+
+    // Casas proibidas ao rei: o mapa de ataque inimigo (calculado sob demanda no modo lazy).
+    // Deslizantes que dão xeque precisam ser estendidos através do rei, para que ele
+    // não "se esconda" atrás de si mesmo recuando na linha do ataque.
+    info.kingDanger = board.attacks(Them);
+
+    uint64_t sliderCheckers = info.checkers & (enemyDiag | enemyOrtho);
+    while (sliderCheckers) {
+        int sq = __builtin_ctzll(sliderCheckers);
+        sliderCheckers &= sliderCheckers - 1;
+
+        if (enemyDiag & BB(sq))  info.kingDanger |= bishopAttacks(sq, all & ~king);
+        if (enemyOrtho & BB(sq)) info.kingDanger |= rookAttacks(sq, all & ~king);
+    }
+
+    return info;
+}
+
+MoveGen::LegalInfo MoveGen::computeLegalInfo(const Board& board) {
+    return board.whiteToMove ? computeLegalInfoFor<SIDE_WHITE>(board)
+                             : computeLegalInfoFor<SIDE_BLACK>(board);
+}
+
+bool MoveGen::enPassantIsLegal(const Board& board, const LegalInfo& info, int from, int to) {
+    if (info.kingSq < 0) return true;
+
+    const bool white = board.whiteToMove;
+    const int capturedSq = white ? (to - 8) : (to + 8);
+
+    // Ocupação depois do lance: os dois peões saem, o nosso chega em 'to'
+    uint64_t occ = board.allPieces();
+    occ &= ~(BB(from) | BB(capturedSq));
+    occ |= BB(to);
+
+    // O peão capturado deixa de existir, então não conta como atacante
+    uint64_t attackers = board.attackersTo(info.kingSq, occ) & enemyPieces(white, board) & ~BB(capturedSq);
+    return attackers == 0;
 }
 
 /*
 // --------------------------------------------------
 // Filtro de lances de promoção, captura e xeque 
 // --------------------------------------------------
-static bool addForcingIfLegal(const Board& board, std::vector<Move>& moves,
+static bool addForcingIfLegal(const Board& board, MoveList& moves,
                               int from, int to, uint8_t flags, uint8_t promotion = EMPTY)
 {
     Move m;
@@ -114,23 +179,10 @@ static bool addForcingIfLegal(const Board& board, std::vector<Move>& moves,
 static int getLeastValuableAttacker(const Board& board, uint64_t attackers, bool whiteToMove) {
     // Ordem de verificação: Peão -> Cavalo -> Bispo -> Torre -> Dama -> Rei
     
-    uint64_t pawns = whiteToMove ? board.whitePawns : board.blackPawns;
-    if (attackers & pawns) return __builtin_ctzll(attackers & pawns);
-
-    uint64_t knights = whiteToMove ? board.whiteKnights : board.blackKnights;
-    if (attackers & knights) return __builtin_ctzll(attackers & knights);
-
-    uint64_t bishops = whiteToMove ? board.whiteBishops : board.blackBishops;
-    if (attackers & bishops) return __builtin_ctzll(attackers & bishops);
-
-    uint64_t rooks = whiteToMove ? board.whiteRooks : board.blackRooks;
-    if (attackers & rooks) return __builtin_ctzll(attackers & rooks);
-
-    uint64_t queens = whiteToMove ? board.whiteQueens : board.blackQueens;
-    if (attackers & queens) return __builtin_ctzll(attackers & queens);
-
-    uint64_t king = whiteToMove ? board.whiteKing : board.blackKing;
-    if (attackers & king) return __builtin_ctzll(attackers & king);
+    const uint64_t* own = board.pieces[whiteToMove ? SIDE_WHITE : SIDE_BLACK];
+    for (int t = PAWN; t <= KING; ++t) {
+        if (attackers & own[t]) return __builtin_ctzll(attackers & own[t]);
+    }
 
     return -1;
 }
@@ -182,11 +234,11 @@ static bool see(const Board& board, int from, int to, int capturedPieceType) {
         if (lvaPiece == WPAWN || lvaPiece == BPAWN || 
             lvaPiece == WBISHOP || lvaPiece == BBISHOP || 
             lvaPiece == WQUEEN || lvaPiece == BQUEEN) {
-            attackers |= (bishopAttacks(to, occ) & (board.whiteBishops | board.blackBishops | board.whiteQueens | board.blackQueens));
+            attackers |= (bishopAttacks(to, occ) & (board.piecesByType(BISHOP) | board.piecesByType(QUEEN)));
         }
         if (lvaPiece == WROOK || lvaPiece == BROOK || 
             lvaPiece == WQUEEN || lvaPiece == BQUEEN) {
-            attackers |= (rookAttacks(to, occ) & (board.whiteRooks | board.blackRooks | board.whiteQueens | board.blackQueens));
+            attackers |= (rookAttacks(to, occ) & (board.piecesByType(ROOK) | board.piecesByType(QUEEN)));
         }
 
         attackerType = lvaPiece;
@@ -204,185 +256,136 @@ static bool see(const Board& board, int from, int to, int capturedPieceType) {
 // =============================================================================================
 // Validador QSearch = Filtro por promoções e capturas que ganham material (avaliação estática)
 // =============================================================================================
-static bool addWinningCaptureIfLegal(const Board& board, std::vector<Move>& moves,
-                                     int from, int to, uint8_t flags, uint8_t promotion = EMPTY)
+static bool addWinningCaptureIfLegal(const Board& board, MoveList& moves,
+                                     int from, int to, MoveKind kind)
 {
     // Filtro Básico: Apenas Capturas e Promoções
-    bool isCapture = flags & CAPTURE;
-    bool isPromotion = flags & PROMOTION;
+    bool isCapture = KIND_FLAGS[kind] & CAPTURE;
+    bool isPromotion = KIND_FLAGS[kind] & PROMOTION;
     if (!isCapture && !isPromotion) return false;
 
-    // Calcula Score MVV-LVA e prepara o objeto Move
-    Move m; m.from = from; m.to = to; m.flags = flags; m.promotion = promotion;
-    m.score = scoreMove(board, from, to, flags, promotion);
+    Move m(from, to, kind);
 
     // Static Exchange Evaluation (SEE)
     // Se a captura parece ruim (vítima <= atacante), verificamos se a troca compensa.
-    if (isCapture) {
-        int victim = board.pieceAt(to);
-        
-        if (flags & EN_PASSANT) {
-            victim = board.whiteToMove ? BPAWN : WPAWN;
-        }
-
-        int victimVal = MVV_LVA_VALUES[victim];
-        int attackerVal = MVV_LVA_VALUES[board.pieceAt(from)];
-
-        // Regra simples para SEE:
-        // 1. Se capturamos peça mais valiosa (PxQ), aceitamos direto (Good Capture), assumindo que demais trocas podem ser interrompidas
-        // por quem já obteve ganho.
-        // 2. Se capturamos igual ou menor (QxP ou PxP), rodamos SEE para ver se não perdemos na troca.
-        if (victimVal <= attackerVal) {
-             if (!see(board, from, to, victim)) {
-                 return false; // SEE diz que perdemos material -> Corta o lance (Pruning)
-             }
-        }
+    if (isCapture && !MoveGen::goodCapture(board, m)) {
+        return false; // SEE diz que perdemos material -> Corta o lance (Pruning)
     }
 
-    Board next = board.applyMove(m);
-    next.updateAttackBoards();
+    moves.push_back(m, scoreMove(board, from, to, kind));
+    return true;
+}
 
-    bool movedByWhite = !next.whiteToMove;
-    if (movedByWhite) {
-        if (next.whiteKing & next.blackAttacks) return false;
-    } else {
-        if (next.blackKing & next.whiteAttacks) return false;
+bool MoveGen::goodCapture(const Board& board, const Move& move)
+{
+    int victim = board.pieceAt(move.to);
+
+    if (move.flags() & EN_PASSANT) {
+        victim = board.whiteToMove ? BPAWN : WPAWN;
     }
 
-    moves.push_back(m);
+    int victimVal = MVV_LVA_VALUES[victim];
+    int attackerVal = MVV_LVA_VALUES[board.pieceAt(move.from)];
+
+    // Regra simples para SEE:
+    // 1. Se capturamos peça mais valiosa (PxQ), aceitamos direto (Good Capture), assumindo que demais trocas podem ser interrompidas
+    // por quem já obteve ganho.
+    // 2. Se capturamos igual ou menor (QxP ou PxP), rodamos SEE para ver se não perdemos na troca.
+    if (victimVal <= attackerVal) {
+        return see(board, move.from, move.to, victim);
+    }
     return true;
 }
 
 struct NormalValidator {
     __attribute__((always_inline))
-    inline bool operator()(const Board& b, std::vector<Move>& m,
-                            int f,int t,uint8_t fl,uint8_t p = EMPTY) const {
-        return validator(b,m,f,t,fl,p);
+    inline bool operator()(const Board& b, MoveList& m,
+                            int f,int t,MoveKind k) const {
+        return validator(b,m,f,t,k);
     }
 };
 
 struct QSearchValidator {
     __attribute__((always_inline))
-    inline bool operator()(const Board& b, std::vector<Move>& m,
-                            int f,int t,uint8_t fl,uint8_t p = EMPTY) const {
-        return addWinningCaptureIfLegal(b,m,f,t,fl,p);
+    inline bool operator()(const Board& b, MoveList& m,
+                            int f,int t,MoveKind k) const {
+        return addWinningCaptureIfLegal(b,m,f,t,k);
     }
 };
 
-std::vector<Move> MoveGen::generateMoves(const Board& board)
-{
-    std::vector<Move> moves;
-    moves.reserve(256);
-    generateAll(board, moves, NormalValidator{});
-    return moves;
-}
-
-std::vector<Move> MoveGen::generatePieceMoves(const Board &board, Piece piece){
-    std::vector<Move> moves;
-    moves.reserve(16);
-
-    if(piece == WPAWN || piece == BPAWN)
-        generatePawnMoves(board, moves, NormalValidator{});
-    else if(piece == WKNIGHT || piece == BKNIGHT)
-        generateKnightMoves(board, moves, NormalValidator{});
-    else if(piece == WBISHOP || piece == BBISHOP)
-        generateBishopMoves(board, moves, NormalValidator{});
-    else if(piece == WROOK || piece == BROOK)
-        generateRookMoves(board, moves, NormalValidator{});
-    else if(piece == WQUEEN || piece == BQUEEN)
-        generateQueenMoves(board, moves, NormalValidator{});
-    else
-        generateKingMoves(board, moves, NormalValidator{});
-    
-    return moves;
-}
-
-std::vector<Move> MoveGen::generateWinningMoves(const Board& board)
+template<GenType Type>
+void MoveGen::generate(const Board& board, const LegalInfo& info, MoveList& moves)
 {
-    std::vector<Move> moves;
-    moves.reserve(64);
-    generateAll(board, moves, QSearchValidator{});
-    return moves;
+    generateAll<Type>(board, info, moves, NormalValidator{});
 }
 
+template void MoveGen::generate<GEN_CAPTURES>(const Board&, const LegalInfo&, MoveList&);
+template void MoveGen::generate<GEN_QUIETS>(const Board&, const LegalInfo&, MoveList&);
+template void MoveGen::generate<GEN_EVASIONS>(const Board&, const LegalInfo&, MoveList&);
+template void MoveGen::generate<GEN_ALL>(const Board&, const LegalInfo&, MoveList&);
 
-std::vector<Move> MoveGen::generateCheckResponses(const Board& board)
+bool MoveGen::isLegal(const Board& board, const LegalInfo& info, const Move& move)
 {
-    std::vector<Move> moves;
-    moves.reserve(32);
-
-    const bool white = board.whiteToMove;
-    const uint64_t own  = ownPieces(white, board);
-    const uint64_t all  = board.allPieces();
-
-    const int kingSq = __builtin_ctzll(white ? board.whiteKing : board.blackKing);
-
-    uint64_t checkers = board.attackersTo(kingSq, all) & enemyPieces(white, board);
+    if (move.from == move.to) return false; // Lance vazio ({}), vindo de TT/killer sem dado
 
-    if (!checkers)
-        return generateMoves(board);
+    Piece piece = board.pieceAt(move.from);
+    if (piece == EMPTY) return false;
+    if (sideOf(piece) != (board.whiteToMove ? SIDE_WHITE : SIDE_BLACK)) return false;
 
-    // ============================================================
-    // DOUBLE CHECK → só rei
-    // ============================================================
-    if (__builtin_popcountll(checkers) > 1) {
-        std::vector<Move> kingOnly;
-        generateKingMoves(board, kingOnly, NormalValidator{});
-        return kingOnly;
-    }
-
-    // ============================================================
-    // SINGLE CHECK
-    // ============================================================
-    const int checkerSq = __builtin_ctzll(checkers);
-    const int checker   = board.pieceAt(checkerSq);
-
-    uint64_t blockMask = 0;
-
-    if (checker >= WBISHOP) // bishop, rook, queen
-        blockMask = squaresBetween(kingSq, checkerSq);
-
-    // ----------------- KING -----------------
-    generateKingMoves(board, moves, NormalValidator{});
-
-    // ----------------- CAPTURE CHECKER -----------------
-    uint64_t attackers = board.attackersTo(checkerSq, all) & own;
+    // Xeque duplo: só o rei pode mover
+    if (__builtin_popcountll(info.checkers) > 1 && typeOf(piece) != KING) return false;
 
-    while (attackers) {
-        int from = __builtin_ctzll(attackers);
-        attackers &= attackers - 1;
+    // Regera apenas os lances do tipo de peça e procura o lance pedido.
+    // O validador não guarda nada, só marca quando encontra.
+    bool found = false;
+    auto match = [&](const Board&, MoveList&, int from, int to, MoveKind kind) {
+        found |= (Move(from, to, kind) == move);
+        return true;
+    };
 
-        bool promo = (board.pieceAt(from) == (white ? WPAWN : BPAWN)) &&
-                     (checkerSq / 8 == (white ? 7 : 0));
+    MoveList unused;
+    if (board.whiteToMove)
+        generateByType<SIDE_WHITE>(board, info, typeOf(piece), unused, match);
+    else
+        generateByType<SIDE_BLACK>(board, info, typeOf(piece), unused, match);
+    return found;
+}
 
-        if (promo) {
-            NormalValidator{}(board, moves, from, checkerSq, CAPTURE|PROMOTION, white ? WQUEEN : BQUEEN);
-            NormalValidator{}(board, moves, from, checkerSq, CAPTURE|PROMOTION, white ? WROOK  : BROOK);
-            NormalValidator{}(board, moves, from, checkerSq, CAPTURE|PROMOTION, white ? WBISHOP: BBISHOP);
-            NormalValidator{}(board, moves, from, checkerSq, CAPTURE|PROMOTION, white ? WKNIGHT: BKNIGHT);
-        } else {
-            NormalValidator{}(board, moves, from, checkerSq, CAPTURE);
-        }
-    }
+MoveList MoveGen::generateMoves(const Board& board)
+{
+    MoveList moves;
+    generateAll(board, computeLegalInfo(board), moves, NormalValidator{});
+    return moves;
+}
 
-    // ----------------- BLOCK RAY -----------------
-    if (blockMask) {
-        uint64_t blockers = blockMask & ~all;
+MoveList MoveGen::generatePieceMoves(const Board &board, Piece piece){
+    MoveList moves;
 
-        while (blockers) {
-            int to = __builtin_ctzll(blockers);
-            blockers &= blockers - 1;
+    const LegalInfo info = computeLegalInfo(board);
 
-            uint64_t cand = board.attackersTo(to, all) & own;
+    // Xeque duplo: só o rei pode mover
+    if (__builtin_popcountll(info.checkers) > 1 && piece != WKING && piece != BKING)
+        return moves;
 
-            while (cand) {
-                int from = __builtin_ctzll(cand);
-                cand &= cand - 1;
-                NormalValidator{}(board, moves, from, to, QUIET);
-            }
-        }
-    }
+    if (board.whiteToMove)
+        generateByType<SIDE_WHITE>(board, info, typeOf(piece), moves, NormalValidator{});
+    else
+        generateByType<SIDE_BLACK>(board, info, typeOf(piece), moves, NormalValidator{});
+    
+    return moves;
+}
 
+MoveList MoveGen::generateWinningMoves(const Board& board)
+{
+    MoveList moves;
+    generateAll<GEN_CAPTURES>(board, computeLegalInfo(board), moves, QSearchValidator{});
     return moves;
 }
 
+
+MoveList MoveGen::generateCheckResponses(const Board& board)
+{
+    // computeLegalInfo já limita os destinos a capturar/bloquear o atacante
+    // (ou só o rei, em xeque duplo), então não há caminho especial aqui.
+    return generateMoves(board);
+}
@@ -1,56 +1,161 @@
 #pragma once
-#include <vector>
 #include "../board/board.h"
 #include "../board/attack.h"
 #include "../board/bitboard.h"
 #include "../board/piece.h"
 #include "move.h"
 
+/**
+ * @brief Conjunto de destinos que um gerador deve emitir.
+ * Usado pelo MovePicker para gerar cada estágio só quando ele é necessário.
+ */
+enum GenType : uint8_t {
+    GEN_CAPTURES,   // Capturas (inclui en passant) e todas as promoções
+    GEN_QUIETS,     // Lances quietos: sem captura e sem promoção (inclui roques)
+    GEN_EVASIONS,   // Respostas a xeque (o checkMask já restringe os destinos)
+    GEN_ALL         // Todos os lances legais
+};
+
 class MoveGen {
 public:
-    
+
     // Para busca genérica
-    static std::vector<Move> generateMoves(const Board& board);
-    
+    static MoveList generateMoves(const Board& board);
+
     // Somente movimento para uma peça, usado na desambiguação da notação clássica
-    static std::vector<Move> generatePieceMoves(const Board& board, Piece piece);
+    static MoveList generatePieceMoves(const Board& board, Piece piece);
 
     // Para Q-search
-    static std::vector<Move> generateWinningMoves(const Board& board);
-    
-    // Otimizado para gerar respostas a xeques
-    static std::vector<Move> generateCheckResponses(const Board& board);
+    static MoveList generateWinningMoves(const Board& board);
+
+    // Respostas a xeques. O gerador legal já restringe os destinos pelo xeque,
+    // então é equivalente a generateMoves
+    static MoveList generateCheckResponses(const Board& board);
+
+    /**
+     * @brief Informações de legalidade calculadas uma única vez por nó.
+     * Com elas os geradores emitem apenas lances legais, sem aplicar o lance
+     * para testar se o rei ficou em xeque. Só o en passant precisa de teste explícito.
+     */
+    struct LegalInfo {
+        int kingSq;           // Casa do rei do lado a jogar (-1 se não houver rei)
+        uint64_t checkers;    // Peças inimigas dando xeque
+        uint64_t pinned;      // Peças próprias cravadas contra o rei
+        uint64_t checkMask;   // Destinos permitidos para peças que não são o rei
+        uint64_t kingDanger;  // Casas atacadas pelo inimigo; os raios dos deslizantes que dão xeque atravessam o rei
+    };
+
+    static LegalInfo computeLegalInfo(const Board& board);
+
+    /**
+     * @brief Gera apenas o conjunto de lances pedido, pontuado por MVV-LVA (em moves.scores).
+     * Os lances são acrescentados ao fim de 'moves' (não limpa a lista).
+     * @tparam Type Capturas, quietos, evasões ou todos
+     * @param info Informações de legalidade do nó, calculadas uma vez e reaproveitadas
+     */
+    template<GenType Type>
+    static void generate(const Board& board, const LegalInfo& info, MoveList& moves);
+
+    /**
+     * @brief Confere se um lance vindo de fora do gerador (TT, killers) é legal na posição.
+     * O tipo do lance também precisa bater: um killer que aqui seria captura é recusado.
+     */
+    static bool isLegal(const Board& board, const LegalInfo& info, const Move& move);
+
+    /**
+     * @brief Verdadeiro se a captura não perde material segundo o SEE.
+     * Capturas de peça mais valiosa que o atacante são aceitas sem rodar o SEE.
+     */
+    static bool goodCapture(const Board& board, const Move& move);
+
 private:
 
     /**
-     * @brief Gera todos os movimentos pseudo-legais para peças filtrado com um validador
+     * @brief Restringe os destinos de uma peça cravada ao raio rei-atacante
+     */
+    static inline uint64_t pinMask(const LegalInfo& info, int from) {
+        return (info.pinned & BB(from)) ? LINE[info.kingSq][from] : ~0ULL;
+    }
+
+    /**
+     * @brief Teste explícito do en passant: as duas peças saem da mesma fileira,
+     * o que pode revelar um xeque descoberto que a lógica de cravada não enxerga.
+     */
+    static bool enPassantIsLegal(const Board& board, const LegalInfo& info, int from, int to);
+
+    /**
+     * @brief Gera todos os movimentos legais, filtrados com um validador
      *
-     * @tparam Validator O filtro (pode filtrar para apenas movimentos legais, capturas, xeques, evasões)
+     * @tparam Type Conjunto de destinos gerado (ver GenType)
+     * @tparam Validator O filtro (pode filtrar para apenas capturas, promoções, etc).
+     * O validador não precisa mais checar legalidade.
      * @param board O Estado atual
-     * @param moves Container que armazena os movimentos finais 
+     * @param moves Container que armazena os movimentos finais
      * @param validator O filtro a ser utilizado
      */
-    template<typename Validator>
-    static void generateAll(const Board& board, std::vector<Move>& moves, Validator&& validator)
+    template<GenType Type = GEN_ALL, typename Validator>
+    static void generateAll(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator)
     {
-        generatePawnMoves(board, moves, validator);
-        generateKnightMoves(board, moves, validator);
-        generateBishopMoves(board, moves, validator);
-        generateRookMoves(board, moves, validator);
-        generateQueenMoves(board, moves, validator);
-        generateKingMoves(board, moves, validator);
+        // O lado a jogar é resolvido uma única vez aqui; daí para baixo tudo é especializado
+        if (board.whiteToMove)
+            generateAllFor<SIDE_WHITE, Type>(board, info, moves, validator);
+        else
+            generateAllFor<SIDE_BLACK, Type>(board, info, moves, validator);
     }
 
-    template<typename Validator>
-    static inline void generatePawnMoves(const Board& board, std::vector<Move>& moves, Validator&& validator) {
-        bool white = board.whiteToMove;
-        uint64_t pawns = white ? board.whitePawns : board.blackPawns;
-        uint64_t enemies = white ? board.blackPieces() : board.whitePieces();
-        uint64_t empty = ~board.allPieces();
+    template<Side Us, GenType Type, typename Validator>
+    static void generateAllFor(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator)
+    {
+        // Xeque duplo: só o rei pode mover
+        if (__builtin_popcountll(info.checkers) > 1) {
+            generateKingMoves<Us, Type>(board, info, moves, validator);
+            return;
+        }
+
+        generatePawnMoves<Us, Type>(board, info, moves, validator);
+        generateKnightMoves<Us, Type>(board, info, moves, validator);
+        generateBishopMoves<Us, Type>(board, info, moves, validator);
+        generateRookMoves<Us, Type>(board, info, moves, validator);
+        generateQueenMoves<Us, Type>(board, info, moves, validator);
+        generateKingMoves<Us, Type>(board, info, moves, validator);
+    }
 
-        int up = white ? 8 : -8;
-        int promRank = white ? 7 : 0;
-        int startRank = white ? 1 : 6;
+    /**
+     * @brief Gera os lances de um único tipo de peça (desambiguação SAN e isLegal)
+     */
+    template<Side Us, typename Validator>
+    static void generateByType(const Board& board, const LegalInfo& info, PieceType type, MoveList& moves, Validator&& validator)
+    {
+        switch (type) {
+            case PAWN:   generatePawnMoves<Us, GEN_ALL>(board, info, moves, validator);   break;
+            case KNIGHT: generateKnightMoves<Us, GEN_ALL>(board, info, moves, validator); break;
+            case BISHOP: generateBishopMoves<Us, GEN_ALL>(board, info, moves, validator); break;
+            case ROOK:   generateRookMoves<Us, GEN_ALL>(board, info, moves, validator);   break;
+            case QUEEN:  generateQueenMoves<Us, GEN_ALL>(board, info, moves, validator);  break;
+            case KING:   generateKingMoves<Us, GEN_ALL>(board, info, moves, validator);   break;
+        }
+    }
+
+    /**
+     * @brief Casas de destino permitidas para peças (exceto peões) conforme o GenType
+     */
+    template<Side Us, GenType Type>
+    static inline uint64_t targetSquares(const Board& board) {
+        if constexpr (Type == GEN_CAPTURES) return piecesOf<~Us>(board);
+        else if constexpr (Type == GEN_QUIETS) return ~board.allPieces();
+        else return ~piecesOf<Us>(board);
+    }
+
+    template<Side Us, GenType Type, typename Validator>
+    static inline void generatePawnMoves(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator) {
+        // Direção e fileiras conhecidas em tempo de compilação
+        constexpr int up = (Us == SIDE_WHITE) ? 8 : -8;
+        constexpr int promRank = (Us == SIDE_WHITE) ? 7 : 0;
+        constexpr int startRank = (Us == SIDE_WHITE) ? 1 : 6;
+
+        uint64_t pawns = board.pieceBB(makePiece(Us, PAWN));
+        uint64_t enemies = piecesOf<~Us>(board);
+        uint64_t empty = ~board.allPieces();
 
         // Iteração padrão de bitboard
         uint64_t copy = pawns;
@@ -60,50 +165,58 @@ private:
 
             int r = from / 8;
 
+            // Destinos permitidos: bloqueio/captura do xeque e raio da cravada
+            uint64_t allowed = info.checkMask & pinMask(info, from);
+
             // --- 1. Movimento Simples (Push) ---
+            // Promoções sem captura pertencem ao estágio de capturas, os demais pushes aos quietos
             int to = from + up;
             if (BB(to) & empty) {
                 // Verifica Promoção
                 if ((to / 8) == promRank) {
-                    validator(board, moves, from, to, PROMOTION, white ? WQUEEN : BQUEEN);
-                    validator(board, moves, from, to, PROMOTION, white ? WROOK : BROOK);
-                    validator(board, moves, from, to, PROMOTION, white ? WBISHOP : BBISHOP);
-                    validator(board, moves, from, to, PROMOTION, white ? WKNIGHT : BKNIGHT);
-                } else {
+                    if (Type != GEN_QUIETS && (BB(to) & allowed)) {
+                        validator(board, moves, from, to, promotionKind(QUEEN, false));
+                        validator(board, moves, from, to, promotionKind(ROOK, false));
+                        validator(board, moves, from, to, promotionKind(BISHOP, false));
+                        validator(board, moves, from, to, promotionKind(KNIGHT, false));
+                    }
+                } else if constexpr (Type != GEN_CAPTURES) {
                     // Push normal
-                    validator(board, moves, from, to, QUIET);
+                    if (BB(to) & allowed)
+                        validator(board, moves, from, to, KIND_QUIET);
 
                     // --- 2. Movimento Duplo (Double Push) ---
-                    // Só possível se o single push foi válido e está no rank inicial
+                    // Só possível se o single push foi possível e está no rank inicial
                     if (r == startRank) {
                         int toDouble = from + (up * 2);
-                        if (BB(toDouble) & empty) {
-                            validator(board, moves, from, toDouble, DOUBLE_PAWN_PUSH);
+                        if (BB(toDouble) & empty & allowed) {
+                            validator(board, moves, from, toDouble, KIND_DOUBLE_PUSH);
                         }
                     }
                 }
             }
 
+            if constexpr (Type == GEN_QUIETS) continue;
+
             // --- 3. Capturas ---
             // Usamos a tabela pré-calculada em attack.h para saber onde esse peão ataca
-            // whiteIndex=0, blackIndex=1 na array PAWN_ATTACKS
-            uint64_t attacks = white ? PAWN_ATTACKS[0][from] : PAWN_ATTACKS[1][from];
+            uint64_t attacks = PAWN_ATTACKS[Us][from];
 
             // Filtra apenas ataques que caem em peças inimigas
-            uint64_t validCaptures = attacks & enemies;
-            
+            uint64_t validCaptures = attacks & enemies & allowed;
+
             // Loop pelas capturas normais
             while (validCaptures) {
                 int captureTo = __builtin_ctzll(validCaptures);
                 validCaptures &= validCaptures - 1;
 
                 if ((captureTo / 8) == promRank) {
-                    validator(board, moves, from, captureTo, PROMOTION | CAPTURE, white ? WQUEEN : BQUEEN);
-                    validator(board, moves, from, captureTo, PROMOTION | CAPTURE, white ? WROOK : BROOK);
-                    validator(board, moves, from, captureTo, PROMOTION | CAPTURE, white ? WBISHOP : BBISHOP);
-                    validator(board, moves, from, captureTo, PROMOTION | CAPTURE, white ? WKNIGHT : BKNIGHT);
+                    validator(board, moves, from, captureTo, promotionKind(QUEEN, true));
+                    validator(board, moves, from, captureTo, promotionKind(ROOK, true));
+                    validator(board, moves, from, captureTo, promotionKind(BISHOP, true));
+                    validator(board, moves, from, captureTo, promotionKind(KNIGHT, true));
                 } else {
-                    validator(board, moves, from, captureTo, CAPTURE);
+                    validator(board, moves, from, captureTo, KIND_CAPTURE);
                 }
             }
 
@@ -111,184 +224,131 @@ private:
             if (board.enPassantSquare != -1) {
                 uint64_t epBB = BB(board.enPassantSquare);
                 // Se o peão ataca a casa de en passant
-                if (attacks & epBB) {
-                    validator(board, moves, from, board.enPassantSquare, EN_PASSANT | CAPTURE);
+                if ((attacks & epBB) && enPassantIsLegal(board, info, from, board.enPassantSquare)) {
+                    validator(board, moves, from, board.enPassantSquare, KIND_EN_PASSANT);
                 }
             }
         }
     }
 
-
-    template<typename Validator>
-    static inline void generateKnightMoves(const Board& board, std::vector<Move>& moves, Validator&& validator) {
-        bool white = board.whiteToMove;
-        uint64_t knights = white ? board.whiteKnights : board.blackKnights;
-        uint64_t own = white ? board.whitePieces() : board.blackPieces();
-        uint64_t enemies = white ? board.blackPieces() : board.whitePieces();
-
-        while (knights) {
-            int from = __builtin_ctzll(knights);
-            knights &= knights - 1;
-
-            // Pega ataques da lookup table e remove peças próprias
-            uint64_t attacks = KNIGHT_ATTACKS[from] & ~own;
-
-            while (attacks) {
-                int to = __builtin_ctzll(attacks);
-                attacks &= attacks - 1;
-
-                bool isCapture = (BB(to) & enemies);
-                validator(board, moves, from, to, isCapture ? CAPTURE : QUIET);
-            }
-        }
-    }
-
-    template<typename Validator>
-    static inline void generateBishopMoves(const Board& board, std::vector<Move>& moves, Validator&& validator) {
-        bool white = board.whiteToMove;
-        uint64_t bishops = white ? board.whiteBishops : board.blackBishops;
-        uint64_t own = white ? board.whitePieces() : board.blackPieces();
-        uint64_t enemies = white ? board.blackPieces() : board.whitePieces();
+    /**
+     * @brief Lances de cavalo, bispo, torre e dama: só muda a função de ataque
+     */
+    template<Side Us, GenType Type, PieceType Pt, typename Validator>
+    static inline void generatePieceTypeMoves(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator) {
+        uint64_t pieces = board.pieceBB(makePiece(Us, Pt));
+        uint64_t targets = targetSquares<Us, Type>(board) & info.checkMask;
+        uint64_t enemies = piecesOf<~Us>(board);
         uint64_t all = board.allPieces();
 
-        while (bishops) {
-            int from = __builtin_ctzll(bishops);
-            bishops &= bishops - 1;
-
-            // Magic Bitboards para gerar ataques deslizantes
-            uint64_t attacks = bishopAttacks(from, all) & ~own;
-
-            while (attacks) {
-                int to = __builtin_ctzll(attacks);
-                attacks &= attacks - 1;
-
-                bool isCapture = (BB(to) & enemies);
-                validator(board, moves, from, to, isCapture ? CAPTURE : QUIET);
-            }
-        }
-    }
+        // Cavalo cravado nunca pode mover (não anda sobre a linha da cravada)
+        if constexpr (Pt == KNIGHT) pieces &= ~info.pinned;
 
-    template<typename Validator>
-    static inline void generateRookMoves(const Board& board, std::vector<Move>& moves, Validator&& validator) {
-        bool white = board.whiteToMove;
-        uint64_t rooks = white ? board.whiteRooks : board.blackRooks;
-        uint64_t own = white ? board.whitePieces() : board.blackPieces();
-        uint64_t enemies = white ? board.blackPieces() : board.whitePieces();
-        uint64_t all = board.allPieces();
+        while (pieces) {
+            int from = __builtin_ctzll(pieces);
+            pieces &= pieces - 1;
 
-        while (rooks) {
-            int from = __builtin_ctzll(rooks);
-            rooks &= rooks - 1;
+            uint64_t attacks;
+            if constexpr (Pt == KNIGHT) attacks = KNIGHT_ATTACKS[from];                  // Lookup table
+            else if constexpr (Pt == BISHOP) attacks = bishopAttacks(from, all);         // Magic Bitboards
+            else if constexpr (Pt == ROOK) attacks = rookAttacks(from, all);
+            else attacks = bishopAttacks(from, all) | rookAttacks(from, all);           // Dama = Bispo | Torre
 
-            uint64_t attacks = rookAttacks(from, all) & ~own;
+            attacks &= targets;
+            if constexpr (Pt != KNIGHT) attacks &= pinMask(info, from);
 
             while (attacks) {
                 int to = __builtin_ctzll(attacks);
                 attacks &= attacks - 1;
 
                 bool isCapture = (BB(to) & enemies);
-                validator(board, moves, from, to, isCapture ? CAPTURE : QUIET);
+                validator(board, moves, from, to, isCapture ? KIND_CAPTURE : KIND_QUIET);
             }
         }
     }
 
-    template<typename Validator>
-    static inline void generateQueenMoves(const Board& board, std::vector<Move>& moves, Validator&& validator) {
-        bool white = board.whiteToMove;
-        uint64_t queens = white ? board.whiteQueens : board.blackQueens;
-        uint64_t own = white ? board.whitePieces() : board.blackPieces();
-        uint64_t enemies = white ? board.blackPieces() : board.whitePieces();
-        uint64_t all = board.allPieces();
-
-        while (queens) {
-            int from = __builtin_ctzll(queens);
-            queens &= queens - 1;
+    template<Side Us, GenType Type, typename Validator>
+    static inline void generateKnightMoves(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator) {
+        generatePieceTypeMoves<Us, Type, KNIGHT>(board, info, moves, validator);
+    }
 
-            // Dama = Bispo | Torre
-            uint64_t attacks = (bishopAttacks(from, all) | rookAttacks(from, all)) & ~own;
+    template<Side Us, GenType Type, typename Validator>
+    static inline void generateBishopMoves(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator) {
+        generatePieceTypeMoves<Us, Type, BISHOP>(board, info, moves, validator);
+    }
 
-            while (attacks) {
-                int to = __builtin_ctzll(attacks);
-                attacks &= attacks - 1;
+    template<Side Us, GenType Type, typename Validator>
+    static inline void generateRookMoves(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator) {
+        generatePieceTypeMoves<Us, Type, ROOK>(board, info, moves, validator);
+    }
 
-                bool isCapture = (BB(to) & enemies);
-                validator(board, moves, from, to, isCapture ? CAPTURE : QUIET);
-            }
-        }
+    template<Side Us, GenType Type, typename Validator>
+    static inline void generateQueenMoves(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator) {
+        generatePieceTypeMoves<Us, Type, QUEEN>(board, info, moves, validator);
     }
 
-    template<typename Validator>
-    static inline void generateKingMoves(const Board& board, std::vector<Move>& moves, Validator&& validator) {
-        bool white = board.whiteToMove;
-        uint64_t king = white ? board.whiteKing : board.blackKing;
-        uint64_t own = white ? board.whitePieces() : board.blackPieces();
-        uint64_t enemies = white ? board.blackPieces() : board.whitePieces();
-        uint64_t enemyAttacks = white ? board.blackAttacks : board.whiteAttacks;
+    template<Side Us, GenType Type, typename Validator>
+    static inline void generateKingMoves(const Board& board, const LegalInfo& info, MoveList& moves, Validator&& validator) {
+        // Casas e direitos de roque do lado (bits: 1=K, 2=Q, 4=k, 8=q)
+        constexpr int kingHome = (Us == SIDE_WHITE) ? 4 : 60;
+        constexpr uint8_t kingSideRight = (Us == SIDE_WHITE) ? 1 : 4;
+        constexpr uint8_t queenSideRight = (Us == SIDE_WHITE) ? 2 : 8;
+        constexpr uint64_t kingSidePath = BB(kingHome + 1) | BB(kingHome + 2);                       // f, g
+        constexpr uint64_t queenSidePath = BB(kingHome - 1) | BB(kingHome - 2) | BB(kingHome - 3);    // d, c, b
+        constexpr uint64_t queenSideSafe = BB(kingHome - 1) | BB(kingHome - 2);                      // b pode estar atacada
+
+        uint64_t targets = targetSquares<Us, Type>(board);
+        uint64_t enemies = piecesOf<~Us>(board);
         uint64_t all = board.allPieces();
 
-        if (king == 0) return; // Segurança
-        int from = __builtin_ctzll(king);
+        if (info.kingSq < 0) return; // Segurança
+        int from = info.kingSq;
 
         // 1. Movimentos normais do Rei
-        // O rei não pode ir para casas controladas pelo inimigo (Pseudo-Legal filtering)
-        // Nota: validator fará a verificação estrita final, mas podemos filtrar o óbvio aqui
-        uint64_t attacks = KING_ATTACKS[from] & ~own & ~enemyAttacks;
+        // O rei não pode ir para casas controladas pelo inimigo. kingDanger é o mapa de
+        // ataque inimigo (calculado com o rei no tabuleiro) mais, para cada deslizante
+        // que dá xeque, o raio estendido através do rei: é essa extensão que barra recuar
+        // na linha do xeque. Não remover em computeLegalInfo.
+        uint64_t attacks = KING_ATTACKS[from] & targets & ~info.kingDanger;
 
         while (attacks) {
             int to = __builtin_ctzll(attacks);
             attacks &= attacks - 1;
 
             bool isCapture = (BB(to) & enemies);
-            validator(board, moves, from, to, isCapture ? CAPTURE : QUIET);
+            validator(board, moves, from, to, isCapture ? KIND_CAPTURE : KIND_QUIET);
         }
 
         // 2. Castling
         // Requisitos: Rei não está em xeque, caminho livre, caminho não atacado.
 
-        // Se o rei já está em xeque, não pode rocar
-        if (king & enemyAttacks) return;
-
-        if (white) {
-            // --- White King Side (K) ---
-            // Direitos bit 0 (1), casas f1(5), g1(6) vazias e não atacadas
-            if ((board.castlingRights & 1) && 
-                !(all & (BB(5) | BB(6))) && 
-                !(enemyAttacks & (BB(5) | BB(6)))) 
-            {
-                validator(board, moves, 4, 6, KING_CASTLE);
-            }
-
-            // --- White Queen Side (Q) ---
-            // Direitos bit 1 (2), casas b1(1), c1(2), d1(3) vazias
-            // Rei passa por c1(2), d1(3), e1(4). c1 e d1 não podem estar atacadas. b1 pode estar atacada.
-            if ((board.castlingRights & 2) && 
-                !(all & (BB(1) | BB(2) | BB(3))) && 
-                !(enemyAttacks & (BB(2) | BB(3)))) 
-            {
-                validator(board, moves, 4, 2, QUEEN_CASTLE);
-            }
+        // Se o rei já está em xeque, não pode rocar. Roque é sempre lance quieto.
+        if (info.checkers || Type == GEN_CAPTURES) return;
 
-        } else {
-            // --- Black King Side (k) ---
-            // Direitos bit 2 (4), casas f8(61), g8(62)
-            if ((board.castlingRights & 4) && 
-                !(all & (BB(61) | BB(62))) && 
-                !(enemyAttacks & (BB(61) | BB(62)))) 
-            {
-                validator(board, moves, 60, 62, KING_CASTLE);
-            }
+        // --- Lado do Rei (K / k) ---
+        if ((board.castlingRights & kingSideRight) &&
+            !(all & kingSidePath) &&
+            !(info.kingDanger & kingSidePath))
+        {
+            validator(board, moves, kingHome, kingHome + 2, KIND_KING_CASTLE);
+        }
 
-            // --- Black Queen Side (q) ---
-            // Direitos bit 3 (8), casas b8(57), c8(58), d8(59)
-            if ((board.castlingRights & 8) && 
-                !(all & (BB(57) | BB(58) | BB(59))) && 
-                !(enemyAttacks & (BB(58) | BB(59)))) 
-            {
-                validator(board, moves, 60, 58, QUEEN_CASTLE);
-            }
+        // --- Lado da Dama (Q / q) ---
+        // Rei passa pelas colunas c e d, que não podem estar atacadas. A coluna b só precisa estar vazia.
+        if ((board.castlingRights & queenSideRight) &&
+            !(all & queenSidePath) &&
+            !(info.kingDanger & queenSideSafe))
+        {
+            validator(board, moves, kingHome, kingHome - 2, KIND_QUEEN_CASTLE);
         }
     }
 
+    template<Side S>
+    inline static uint64_t piecesOf(const Board& b) {
+        if constexpr (S == SIDE_WHITE) return b.whitePieces();
+        else return b.blackPieces();
+    }
+
     inline static uint64_t ownPieces(bool white, const Board& b) {
         return white ? b.whitePieces() : b.blackPieces();
     }
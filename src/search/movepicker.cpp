@@ -0,0 +1,159 @@
+#include "movepicker.h"
+#include "search.h"
+
+MovePicker::MovePicker(const Board& b, const Move& tt, const Move* killerMoves, const int (*hist)[64])
+    : board(b), info(MoveGen::computeLegalInfo(b)), ttMove(tt), history(hist)
+{
+    killers[0] = killers[1] = Move{};
+    if (killerMoves) {
+        killers[0] = killerMoves[0];
+        killers[1] = killerMoves[1];
+    }
+
+    // O hash move pode ser de outra posição (colisão) ou estar vazio
+    if (!MoveGen::isLegal(board, info, ttMove))
+        ttMove = Move{};
+
+    stage = inCheck() ? STAGE_EVASIONS_TT : STAGE_TT;
+}
+
+Move MovePicker::pickBest(int end) {
+    int best = cur;
+    for (int i = cur + 1; i < end; ++i) {
+        if (moves.score(i) > moves.score(best))
+            best = i;
+    }
+    moves.swap(cur, best);
+    return moves[cur++];
+}
+
+void MovePicker::scoreQuiets(int begin) {
+    for (int i = begin; i < moves.size(); ++i) {
+        const Move& m = moves[i];
+        if (m.flags() & (CAPTURE | PROMOTION)) continue; // Evasões: capturas mantêm o MVV-LVA
+
+        moves.score(i) = history[m.from][m.to];
+        if (moves.score(i) > MAX_HISTORY)
+            moves.score(i) = MAX_HISTORY;
+    }
+}
+
+bool MovePicker::next(Move& move) {
+    switch (stage) {
+
+    // ===== Fora de xeque =====
+    case STAGE_TT:
+        stage = STAGE_CAPTURES_INIT;
+        if (ttMove.from != ttMove.to) {
+            move = ttMove;
+            return true;
+        }
+        [[fallthrough]];
+
+    case STAGE_CAPTURES_INIT:
+        MoveGen::generate<GEN_CAPTURES>(board, info, moves);
+        cur = 0;
+        endBadCaptures = 0;
+        stage = STAGE_GOOD_CAPTURES;
+        [[fallthrough]];
+
+    case STAGE_GOOD_CAPTURES:
+        while (cur < moves.size()) {
+            Move m = pickBest(moves.size());
+            if (m == ttMove) continue;
+
+            // Capturas que perdem material ficam para o fim. 'cur' já passou
+            // deste índice, então ele pode ser reaproveitado no início da lista.
+            if ((m.flags() & CAPTURE) && !(m.flags() & PROMOTION) && !MoveGen::goodCapture(board, m)) {
+                moves[endBadCaptures++] = m;
+                continue;
+            }
+
+            move = m;
+            return true;
+        }
+        stage = STAGE_KILLER_1;
+        [[fallthrough]];
+
+    case STAGE_KILLER_1:
+        stage = STAGE_KILLER_2;
+        if (killers[0] != ttMove && MoveGen::isLegal(board, info, killers[0])
+            && !(killers[0].flags() & (CAPTURE | PROMOTION))) {
+            move = killers[0];
+            return true;
+        }
+        killers[0] = Move{}; // Não foi entregue, não precisa ser pulado nos quietos
+        [[fallthrough]];
+
+    case STAGE_KILLER_2:
+        stage = STAGE_QUIETS_INIT;
+        if (killers[1] != ttMove && killers[1] != killers[0] && MoveGen::isLegal(board, info, killers[1])
+            && !(killers[1].flags() & (CAPTURE | PROMOTION))) {
+            move = killers[1];
+            return true;
+        }
+        killers[1] = Move{};
+        [[fallthrough]];
+
+    case STAGE_QUIETS_INIT:
+        // Os quietos vão depois das capturas já entregues; as ruins continuam no início
+        cur = moves.size();
+        MoveGen::generate<GEN_QUIETS>(board, info, moves);
+        scoreQuiets(cur);
+        stage = STAGE_QUIETS;
+        [[fallthrough]];
+
+    case STAGE_QUIETS:
+        while (cur < moves.size()) {
+            Move m = pickBest(moves.size());
+            if (isSpecial(m)) continue;
+
+            move = m;
+            return true;
+        }
+        cur = 0;
+        stage = STAGE_BAD_CAPTURES;
+        [[fallthrough]];
+
+    case STAGE_BAD_CAPTURES:
+        // Já estão em ordem de MVV-LVA (foram separadas durante a seleção)
+        if (cur < endBadCaptures) {
+            move = moves[cur++];
+            return true;
+        }
+        stage = STAGE_DONE;
+        return false;
+
+    // ===== Em xeque =====
+    case STAGE_EVASIONS_TT:
+        stage = STAGE_EVASIONS_INIT;
+        if (ttMove.from != ttMove.to) {
+            move = ttMove;
+            return true;
+        }
+        [[fallthrough]];
+
+    case STAGE_EVASIONS_INIT:
+        MoveGen::generate<GEN_EVASIONS>(board, info, moves);
+        scoreQuiets(0);
+        cur = 0;
+        stage = STAGE_EVASIONS;
+        [[fallthrough]];
+
+    case STAGE_EVASIONS:
+        while (cur < moves.size()) {
+            Move m = pickBest(moves.size());
+            if (m == ttMove) continue;
+
+            move = m;
+            return true;
+        }
+        stage = STAGE_DONE;
+        [[fallthrough]];
+
+    case STAGE_DONE:
+        return false;
+    }
+
+    return false;
+}
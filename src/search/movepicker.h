@@ -0,0 +1,77 @@
+#pragma once
+#include "../board/board.h"
+#include "../move/movegen.h"
+#include "../move/move.h"
+
+/**
+ * @brief Entrega os lances de um nó em estágios, gerando cada estágio só quando necessário.
+ *
+ * Ordem fora de xeque:
+ *  1. Hash Move (da TT, depois de conferir se é legal na posição)
+ *  2. Capturas boas (MVV-LVA, SEE >= 0) e promoções
+ *  3. Killer moves do ply
+ *  4. Lances quietos ordenados pelo history
+ *  5. Capturas ruins (SEE < 0)
+ *
+ * Em xeque: Hash Move e depois todas as evasões (capturas por MVV-LVA, quietos pelo history).
+ *
+ * Em vez de ordenar a lista inteira, cada chamada de next() faz um passo de
+ * selection sort: a maioria dos nós de corte só precisa do primeiro lance.
+ */
+class MovePicker {
+public:
+    /**
+     * @param board Posição do nó (não pode mudar enquanto o picker estiver em uso)
+     * @param ttMove Lance da TT (pode ser vazio ou inválido, é conferido)
+     * @param killers Os dois killers do ply (nullptr para não usar)
+     * @param history Tabela de history do lado a jogar, indexada por [from][to]
+     */
+    MovePicker(const Board& board, const Move& ttMove, const Move* killers, const int (*history)[64]);
+
+    /**
+     * @brief Próximo lance legal, ou false quando não há mais lances
+     */
+    bool next(Move& move);
+
+    bool inCheck() const { return info.checkers != 0; }
+
+private:
+    enum Stage : uint8_t {
+        STAGE_TT,
+        STAGE_CAPTURES_INIT,
+        STAGE_GOOD_CAPTURES,
+        STAGE_KILLER_1,
+        STAGE_KILLER_2,
+        STAGE_QUIETS_INIT,
+        STAGE_QUIETS,
+        STAGE_BAD_CAPTURES,
+        STAGE_EVASIONS_TT,
+        STAGE_EVASIONS_INIT,
+        STAGE_EVASIONS,
+        STAGE_DONE
+    };
+
+    const Board& board;
+    MoveGen::LegalInfo info;
+
+    Move ttMove;
+    Move killers[2];
+    const int (*history)[64];
+
+    Stage stage;
+    MoveList moves;
+    int cur = 0;          // Próximo índice a ser escolhido na lista
+    int endBadCaptures = 0; // Capturas ruins são guardadas em [0, endBadCaptures)
+
+    /**
+     * @brief Um passo de selection sort: traz o maior score de [cur, end) para 'cur'
+     */
+    Move pickBest(int end);
+
+    // Lances já entregues em estágios anteriores
+    bool isSpecial(const Move& m) const {
+        return m == ttMove || m == killers[0] || m == killers[1];
+    }
+
+    void scoreQuiets(int begin);
+};
@@ -1,128 +1,403 @@
 #include "search.h"
+#include "movepicker.h"
 #include "../eval/eval.h"
 #include "../debuglib/debug.h"
 #include "../tt/tt.h"
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <thread>
+
+// Lazy SMP: os helpers pulam algumas profundidades para não repetirem a busca
+// da thread principal em sincronia. O helper i usa SKIP_SIZE/SKIP_PHASE[(i - 1) % 20].
+static constexpr int SKIP_SIZE[20]  = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+static constexpr int SKIP_PHASE[20] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+// LMR: redução base por profundidade e número do lance, LMR_BASE + ln(depth) * ln(lance) / LMR_DIVISOR
+static constexpr double LMR_BASE = 0.75;
+static constexpr double LMR_DIVISOR = 2.25;
+
+static const auto LMR_TABLE = [] {
+    std::array<std::array<int, 64>, MAX_PLY> table{};
+    for (int d = 1; d < MAX_PLY; ++d) {
+        for (int m = 1; m < 64; ++m) {
+            table[d][m] = int(LMR_BASE + std::log(d) * std::log(m) / LMR_DIVISOR);
+        }
+    }
+    return table;
+}();
+
+// ==================================================
+//  Searcher
+// ==================================================
+Searcher::Searcher(TranspositionTable& table) : tt(table) {
+    setThreads(1);
+}
+
+void Searcher::setThreads(int n) {
+    n = std::clamp(n, 1, MAX_THREADS);
+
+    // Contextos já criados são mantidos (com as suas tabelas) entre as buscas
+    while (int(contexts.size()) > n) contexts.pop_back();
+    while (int(contexts.size()) < n) {
+        contexts.push_back(std::make_unique<SearchContext>(*this, int(contexts.size())));
+    }
+}
 
 /**
  * @brief Inicia a busca pelo melhor lance na raiz.
- * * Atualmente usa uma busca de profundidade fixa (Fixed Depth).
- * * TODO Futuro: Implementar Iterative Deepening (ID).
- * Em vez de chamar searchBestMove(depth 5) direto, chamar para 1, depois 2, até 5.
- * Isso ajuda muito no ordenamento de movimentos e gerenciamento de tempo.
+ * * Com mais de uma thread (Lazy SMP), as auxiliares rodam o mesmo iterative
+ * deepening na mesma raiz, compartilhando só a TT. Elas não trocam mensagens:
+ * o ganho vem das entradas que uma grava e as outras aproveitam.
+ * Ao fim, o lance é escolhido por votação entre as threads.
  */
-Move Search::searchBestMove(const Board& board, int maxDepth) {
+Move Searcher::searchBestMove(const Board& board, const SearchLimits& searchLimits) {
+    Debug::RAII_Timer raii_timer("Search");
+
+    limits = searchLimits;
+    timer.init(limits, board.whiteToMove);
+    int maxDepth = limits.depth > 0 ? std::min(limits.depth, MAX_PLY - 1) : MAX_PLY - 1;
+
+    tt.newSearch();
+    nodesSearched.store(0, std::memory_order_relaxed);
+    stopSearch.store(false, std::memory_order_relaxed);
+    pondering.store(limits.ponder, std::memory_order_relaxed);
+
+    // Os mapas de ataque são um cache preguiçoso (mutable): calcula antes de as
+    // threads copiarem o tabuleiro, senão várias o preencheriam ao mesmo tempo
+    board.ensureAttacks();
+
+    int numThreads = threads();
+    std::thread helpers[MAX_THREADS];
+    for (int i = 1; i < numThreads; ++i) {
+        helpers[i] = std::thread([this, &board, maxDepth, i]() {
+            contexts[i]->iterativeDeepening(board, maxDepth);
+        });
+    }
+
+    contexts[0]->iterativeDeepening(board, maxDepth);
+
+    // A thread principal terminou (profundidade, limite ou stop): os helpers param onde estiverem
+    stopSearch.store(true, std::memory_order_relaxed);
+    for (int i = 1; i < numThreads; ++i) {
+        helpers[i].join();
+    }
+
+    bestResult = pickBestThread();
+
+    lastSearch = {};
+    for (const auto& ctx : contexts) {
+        lastSearch += ctx->stats();
+    }
+
+    return bestResult.bestMove;
+}
+
+void Searcher::checkLimits() {
+    // Sem nenhuma iteração completa ainda não há lance para devolver: segue até ter um
+    if (contexts[0]->result().depth == 0) return;
+
+    bool nodesExceeded = limits.nodes && nodesSearched.load(std::memory_order_relaxed) >= limits.nodes;
+    bool timeExceeded = !pondering.load(std::memory_order_relaxed) && timer.hardLimitReached();
+    if (nodesExceeded || timeExceeded) {
+        stopSearch.store(true, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Votação entre as threads: cada uma vota no seu lance com peso
+ * (score - pior score + 14) * depth. Ganha o lance mais votado; em empate, fica
+ * a thread de menor índice (a principal vem primeiro).
+ */
+const SearchContext::Result& Searcher::pickBestThread() const {
+    int count = threads();
+
+    int minScore = INF;
+    for (int i = 0; i < count; ++i) {
+        const auto& r = contexts[i]->result();
+        if (r.depth > 0) minScore = std::min(minScore, r.score);
+    }
+
+    int64_t votes[MAX_THREADS] = {};
+    for (int i = 0; i < count; ++i) {
+        const auto& r = contexts[i]->result();
+        if (r.depth == 0) continue; // Helper parado antes de completar uma iteração
+        for (int j = 0; j < count; ++j) {
+            // Candidato só com iteração completa: com depth 0 o bestMove é o
+            // fallback moves[0], sem score nem PV
+            const auto& candidate = contexts[j]->result();
+            if (candidate.depth > 0 && candidate.bestMove == r.bestMove)
+                votes[j] += int64_t(r.score - minScore + 14) * r.depth;
+        }
+    }
+
+    int best = 0;
+    for (int i = 1; i < count; ++i) {
+        if (votes[i] > votes[best]) best = i;
+    }
+    return contexts[best]->result();
+}
+
+// ==================================================
+//  SearchContext
+// ==================================================
+SearchContext::SearchContext(Searcher& searcher, int id) : owner(searcher), threadId(id) {}
+
+bool SearchContext::stopped() const {
+    return owner.stopSearch.load(std::memory_order_relaxed);
+}
+
+void SearchContext::poll() {
+    if (--pollCountdown > 0) return;
+    pollCountdown = POLL_NODES;
+
+    owner.nodesSearched.fetch_add(POLL_NODES, std::memory_order_relaxed);
+    if (threadId == 0) owner.checkLimits();
+}
+
+void SearchContext::iterativeDeepening(const Board& board, int maxDepth) {
+    TranspositionTable& tt = owner.tt;
+
     // ============= DEBUG ================
-    Search::stats.nodes  = 0;
-    Search::stats.qnodes = 0;
-    Search::stats.evaluations = 0;
+    searchStats = {};
 
-    Debug::RAII_Timer raii_timer("Search");
     Debug::Stopwatch stopwatch;
 
     // ====================================
     std::memset(killerMoves, 0, sizeof(killerMoves));
     std::memset(history, 0, sizeof(history));
-    TT.newSearch();
-     
-    Move globalBestMove = {};
-    int globalBestScore = -INF;
+    pollCountdown = POLL_NODES;
+    nmpMinPly = 0;
+
+    Result& result = lastResult;
+    result = {};
+    bool mainThread = (threadId == 0);
+
+    // Semeia a pilha de repetições com o fim do jogo (só o que cabe)
+    const std::vector<uint64_t>& gameKeys = owner.gameKeys;
+    rootIndex = std::min<int>(gameKeys.size(), MAX_GAME_KEYS);
+    std::copy(gameKeys.end() - rootIndex, gameKeys.end(), keyStack);
+    keyStack[rootIndex] = board.hashKey;
+
+    // Iterações seguidas em que o melhor lance não mudou (usado pelo time manager)
+    int stability = 0;
+
+    // Cópia de trabalho: a busca aplica e desfaz lances nela (make/unmake)
+    Board root = board;
 
     // === ITERATIVE DEEPENING ===
     // Vai de 1 até a profundidade máxima pedida
     for (int currentDepth = 1; currentDepth <= maxDepth; ++currentDepth) {
-        
-        // Janela de Aspiração (Resetamos Alpha/Beta a cada nova profundidade)
-        int alpha = -INF;
-        int beta = INF;
 
+        // Helpers pulam algumas profundidades (mas nunca a última)
+        if (!mainThread && currentDepth < maxDepth) {
+            int idx = (threadId - 1) % 20;
+            if (((currentDepth + SKIP_PHASE[idx]) / SKIP_SIZE[idx]) % 2)
+                continue;
+        }
+        
         // Geramos os movimentos novamente a cada iteração
         // Isso é necessário porque a ordenação muda conforme a TT é preenchida
-        std::vector<Move> moves = MoveGen::generateMoves(board);
-        if (moves.empty()) return {};
+        // (sempre na cópia da thread: 'board' é compartilhado com os helpers)
+        MoveList moves = MoveGen::generateMoves(root);
+        if (moves.empty()) break;
 
-        // Descobre o Hash Move dessa iteração (vindo da iteração anterior)
+        // Descobre o melhor lance da iteração anterior: o início da PV ou, sem
+        // ela, o Hash Move (que pode ter sido sobrescrito por outra thread)
         Move ttMove = {};
         TTEntry entry;
-        if (TT.probe(board.hashKey, entry, 0)) {
-            ttMove = unpackMove(entry.move);
+        if (result.pvLength > 0) {
+            ttMove = result.pv[0];
+        } else if (tt.probe(root.hashKey, entry, 0)) {
+            ttMove = entry.move;
         }
 
         // Aplica bônus no Hash Move
-        for (auto& m : moves) {
-            if (m == ttMove) {
-                m.score = 30000; // Prioridade máxima
+        for (int i = 0; i < moves.size(); ++i) {
+            if (moves[i] == ttMove) {
+                moves.score(i) = 30000; // Prioridade máxima
                 break;
             }
         }
 
         // Ordena (Agora o melhor lance da depth anterior será o primeiro)
-        std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b){
-            return a.score > b.score;
-        });
+        moves.sort();
+
+        // Se a busca for parada antes da primeira iteração completa, devolve
+        // pelo menos um lance legal (não entra na votação, já que depth == 0)
+        if (result.depth == 0) result.bestMove = moves[0];
+
+        // === JANELA DE ASPIRAÇÃO ===
+        // A partir de certa profundidade o score muda pouco de uma iteração para
+        // a outra: busca com uma janela estreita em torno do anterior, que poda
+        // mais. Se o score cair fora dela, alarga o lado que falhou e repete.
+        const SearchParams& params = owner.searchParams;
+        int delta = params.aspirationDelta;
+        int alpha = -INF;
+        int beta = INF;
+
+        if (params.useAspiration && currentDepth >= params.aspirationMinDepth
+            && result.depth > 0 && std::abs(result.score) < MATE_SCORE - MAX_PLY) {
+            alpha = std::max(result.score - delta, -INF);
+            beta  = std::min(result.score + delta, INF);
+        }
 
-        // Root Search (Busca na Raiz)
         Move iterationBestMove = {};
         int iterationBestScore = -INF;
-        
-        for (const auto& move : moves) {
-            Board nextBoard = board.applyMove(move);
-            nextBoard.updateAttackBoards();
 
-            int score = -negamax(nextBoard, currentDepth - 1, -beta, -alpha, 1);
-
-            if (score > iterationBestScore) {
-                iterationBestScore = score;
-                iterationBestMove = move;
+        while (true) {
+            iterationBestScore = searchRoot(root, moves, currentDepth, alpha, beta, iterationBestMove);
+
+            if (stopped()) break;
+
+            if (iterationBestScore <= alpha && alpha > -INF) {
+                // Fail low: o score real está abaixo. Puxa o beta junto para a
+                // re-busca não gastar nós acima do que acabou de ser refutado
+                beta = (alpha + beta) / 2;
+                alpha = std::max(iterationBestScore - delta, -INF);
+            } else if (iterationBestScore >= beta && beta < INF) {
+                // Fail high: o score real está acima
+                beta = std::min(iterationBestScore + delta, INF);
+            } else {
+                break; // Dentro da janela: score exato
             }
 
-            if (score > alpha) {
-                alpha = score;
-                // Encontramos um novo melhor lance (PV), gravamos na TT imediatamente
-                // para que, se pararmos o tempo agora, a informação esteja salva.
-                // Quando implementar limite de tempo, parar depois desse passo
-                TT.store(board.hashKey, currentDepth, score, TT_EXACT, move, 0);
+            ++searchStats.aspirationResearches[currentDepth];
+
+            delta += delta / 2;
+            if (delta > params.aspirationMaxDelta) {
+                alpha = -INF;
+                beta = INF;
             }
         }
 
-        // Atualiza o melhor lance global
-        globalBestMove = iterationBestMove;
-        globalBestScore = iterationBestScore;
+        // Interrompida (limite, stop() ou helper): a iteração ficou incompleta e é
+        // descartada, o resultado continua sendo o da última iteração completa
+        if (stopped()) break;
+
+        stability = (result.depth > 0 && iterationBestMove == result.bestMove) ? stability + 1 : 0;
+
+        // Atualiza o resultado com a iteração completa
+        result.bestMove = iterationBestMove;
+        result.score = iterationBestScore;
+        result.depth = currentDepth;
+
+        result.pvLength = pvLength[0];
+        std::copy(pvTable[0], pvTable[0] + pvLength[0], result.pv);
+        if (result.pvLength == 0) {
+            result.pv[0] = iterationBestMove;
+            result.pvLength = 1;
+        }
+
+        if (!mainThread) continue;
 
+#ifdef DEBUG
         // Stats da iteração 
-        // Aqui printa o "pensamento" da engine
-        uint64_t timeMs = stopwatch.elapsed_us();
-        if (timeMs == 0) timeMs = 1; 
-        
-        uint64_t totalNodes = stats.nodes + stats.qnodes;
+        // Aqui printa o "pensamento" da engine (só na build de debug: montar a PV aloca strings)
+        int64_t timeMs = std::max<int64_t>(owner.timer.elapsed(), 1);
+
+        uint64_t totalNodes = searchStats.nodes + searchStats.qnodes;
         uint64_t nps = (totalNodes * 1000) / timeMs;
 
         Debug::cout << "info depth " << currentDepth 
-                    << " score " << globalBestScore 
+                    << " score " << scoreToUCI(result.score)
                     << " nodes " << totalNodes 
                     << " nps " << nps 
-                    << " pv " << (int)globalBestMove.from << "->" << (int)globalBestMove.to << "\n";
+                    << " time " << timeMs
+                    << " pv " << pvToUCI(result) << "\n";
+#endif
+
+        if (owner.infoCallback) {
+            // Soma os nós desta thread ainda não publicados
+            uint64_t nodes = owner.nodesSearched.load(std::memory_order_relaxed) + (POLL_NODES - pollCountdown);
+            owner.infoCallback({ result, nodes, owner.timer.elapsed(), tt.hashfull() });
+        }
+
+        // Limites conferidos entre iterações: o de nós e o soft limit de tempo
+        // (não adianta começar uma iteração que não vai terminar)
+        const SearchLimits& limits = owner.limits;
+        if (limits.nodes && owner.nodesSearched.load(std::memory_order_relaxed) >= limits.nodes) break;
+        if (!owner.pondering.load(std::memory_order_relaxed) && owner.timer.softLimitReached(stability)) break;
     }
+
+    if (!mainThread) return;
     
     uint64_t us = stopwatch.elapsed_us();
-    uint64_t total_nodes = stats.nodes + stats.qnodes;
+    uint64_t total_nodes = searchStats.nodes + searchStats.qnodes;
     
     uint64_t nps = (total_nodes * 1000000) / us;
 
     Debug::cout << "\n=== Search Statistics ===\n";
-    Debug::cout << "Depth:       " << maxDepth << "\n";
+    Debug::cout << "Depth:       " << result.depth << "\n";
     Debug::cout << "Time:        " << (us / 1000.0) << " ms\n";
-    Debug::cout << "Nodes:       " << stats.nodes << " (Interior)\n";
-    Debug::cout << "QNodes:      " << stats.qnodes << " (Quiescence)\n";
+    Debug::cout << "Nodes:       " << searchStats.nodes << " (Interior)\n";
+    Debug::cout << "QNodes:      " << searchStats.qnodes << " (Quiescence)\n";
     Debug::cout << "Total Nodes: " << total_nodes << "\n";
-    Debug::cout << "Evaluations: " << stats.evaluations << "\n";
+    Debug::cout << "Evaluations: " << searchStats.evaluations << "\n";
     Debug::cout << "NPS:         " << nps << " nodes/sec\n";
-    Debug::cout << "Evaluation:  " << globalBestScore << "\n";
-    Debug::cout << "TT Permill:  " << TT.hashfull() << "\n";
+    Debug::cout << "Evaluation:  " << result.score << "\n";
+    Debug::cout << "TT Permill:  " << tt.hashfull() << "\n";
     Debug::cout << "=========================\n";
+}
+
+int SearchContext::searchRoot(Board& root, MoveList& moves, int depth, int alpha, int beta, Move& bestMove) {
+    TranspositionTable& tt = owner.tt;
+    int bestScore = -INF;
+    bestMove = {};
+    pvLength[0] = 0;
+    followPV[0] = true;
+
+    for (int i = 0; i < moves.size(); ++i) {
+        Move move = moves[i];
+        followPV[1] = lastResult.pvLength > 0 && move == lastResult.pv[0];
+
+        StateInfo st;
+        root.makeMove(move, st);
+
+        // A raiz é um nó PV: o primeiro lance com a janela cheia, os demais
+        // com janela nula e re-busca se passarem de alpha. Sem PVS os demais
+        // usam a janela cheia, mas continuam nós não-PV
+        int score;
+        if (i == 0) {
+            score = -negamax<NODE_PV>(root, depth - 1, -beta, -alpha, 1);
+        } else if (!owner.searchParams.usePVS) {
+            score = -negamax<NODE_NON_PV>(root, depth - 1, -beta, -alpha, 1);
+        } else {
+            score = -negamax<NODE_NON_PV>(root, depth - 1, -alpha - 1, -alpha, 1);
+            if (score > alpha && score < beta && !stopped())
+                score = -negamax<NODE_PV>(root, depth - 1, -beta, -alpha, 1);
+        }
 
-    return globalBestMove;
+        root.unmakeMove(move, st);
+
+        // Busca interrompida: o chamador descarta a iteração
+        if (stopped()) return bestScore;
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+        }
+
+        if (score > alpha) updatePV(0, move);
+
+        if (score >= beta) {
+            // Fail high: o lance vai para o início e a re-busca começa por ele
+            for (int j = i; j > 0; --j) moves.swap(j, j - 1);
+            tt.store(root.hashKey, depth, score, TT_BETA, move, 0);
+            return score;
+        }
+
+        if (score > alpha) {
+            alpha = score;
+            // Encontramos um novo melhor lance (PV), gravamos na TT imediatamente
+            // para que, se pararmos o tempo agora, a informação esteja salva.
+            tt.store(root.hashKey, depth, score, TT_EXACT, move, 0);
+        }
+    }
+
+    return bestScore;
 }
 
 /**
@@ -130,20 +405,40 @@ Move Search::searchBestMove(const Board& board, int maxDepth) {
  * * @param ply Distância da raiz (root). Usado para calcular "Mate em X".
  * Se encontrarmos um mate com ply 3 e outro com ply 5, o score do ply 3 será maior,
  * fazendo a engine preferir o mate mais rápido.
+ *
+ * PVS (Principal Variation Search): com uma boa ordenação o primeiro lance
+ * quase sempre é o melhor. Ele é buscado com a janela cheia e os demais só
+ * precisam provar que não o superam, o que uma janela nula (alpha, alpha+1)
+ * faz com bem menos nós. Quem passar de alpha é re-buscado com a janela cheia.
  */
-int Search::negamax(const Board& board, int depth, int alpha, int beta, int ply) {
-    ++Search::stats.nodes;
+template<NodeType NT>
+int SearchContext::negamax(Board& board, int depth, int alpha, int beta, int ply, bool allowNull) {
+    constexpr bool pvNode = (NT == NODE_PV);
+    const SearchParams& params = owner.searchParams;
+
+    // PV vazia até algum lance melhorar alpha
+    pvLength[ply] = ply;
+
+    ++searchStats.nodes;
+    poll();
     int alphaOrig = alpha;
+
+    // Limite da pilha (só com muitas extensões de xeque)
+    if (ply >= MAX_PLY) return Eval::evaluate(board);
+
+    // Empates pelo histórico (repetição e 50 lances): a TT não enxerga o caminho,
+    // então isso vem antes dela. A raiz (ply 0) não passa por aqui e sempre tem um lance.
+    keyStack[rootIndex + ply] = board.hashKey;
+    if (isDraw(board, ply)) return 0;
     
-    bool inCheck = board.whiteToMove ? (board.whiteKing & board.blackAttacks) 
-                                     : (board.blackKing & board.whiteAttacks);
+    bool inCheck = board.inCheck();
     // Se em xeque, estende a busca
     if (inCheck) {
         depth++;
     }
 
-    if (depth == 0) {
-        ++Search::stats.evaluations;
+    if (depth <= 0) {
+        ++searchStats.evaluations;
         return quiescence(board, alpha, beta);
     }
     
@@ -151,11 +446,12 @@ int Search::negamax(const Board& board, int depth, int alpha, int beta, int ply)
     TTEntry ttEntry;
     Move ttMove = {};
     
-    if (TT.probe(board.hashKey, ttEntry, ply)) {
-        ttMove = unpackMove(ttEntry.move);
+    if (owner.tt.probe(board.hashKey, ttEntry, ply)) {
+        ttMove = ttEntry.move;
 
-        // TT Cutoff (Só se depth for suficiente)
-        if (ttEntry.depth >= depth) {
+        // TT Cutoff (Só se depth for suficiente). Nós PV não cortam: o score
+        // exato tem que vir da busca, senão a variante principal é truncada
+        if (!pvNode && ttEntry.depth >= depth) {
             if (ttEntry.flag == TT_EXACT) {
                 return ttEntry.score;
             }
@@ -168,100 +464,205 @@ int Search::negamax(const Board& board, int depth, int alpha, int beta, int ply)
         }
     }
 
-    std::vector<Move> moves = MoveGen::generateMoves(board);
+    int side = board.whiteToMove ? 0 : 1;
 
-    if (moves.empty()) {
-        // Se não há lances legais, ou é Mate ou é Afogamento (Stalemate).
-        if (inCheck) {
-            // Xeque-mate!
-            // Retornamos -MATE + ply. 
-            // Quanto menor o ply (mais perto da raiz), maior o score (menos negativo).
-            // Isso incentiva a engine a dar mate rápido e adiar levar mate.
-            return -MATE_SCORE + ply; 
-        } else {
-            // Afogamento (Empate)
-            return 0;
-        }
+    // Avaliação estática do nó, base das podas abaixo (em xeque ela não vale nada)
+    int staticEval = -INF;
+    if (!inCheck) {
+        ++searchStats.evaluations;
+        staticEval = Eval::evaluate(board);
     }
 
+    // Podas do nó inteiro: só fora de xeque, fora dos nós PV e longe de scores de mate
+    bool nodePruning = !pvNode && !inCheck && std::abs(beta) < MATE_SCORE - MAX_PLY;
+
     // =============================================================
-    // Move Ordering (Ordenação de Movimentos)
+    // Reverse Futility Pruning (static null move)
     // =============================================================
-    // TODO: Implementar heurísticas de ordenação.
-    // O Alpha-Beta funciona muito melhor se analisarmos os melhores lances primeiro.
-    //  1. Hash Move (da Transposition Table - Futuro)
-    //  2. Capturas (MVV-LVA: Most Valuable Victim - Least Valuable Attacker)
-    //  3. Killer Moves (lances que causaram beta cutoff em irmãos)
-    //  4. History Heuristic
-    //  5. Demais lances
+    // Perto das folhas, se o eval passa de beta com folga, o oponente
+    // dificilmente recupera em poucos plies: corta direto
+    if (nodePruning && params.useRFP && depth <= params.rfpMaxDepth
+        && staticEval - params.rfpMargin * depth >= beta) {
+        return staticEval;
+    }
 
-    // Atualmente atualmente usando MVL-LVA + Killer Moves
-    
     // =============================================================
-    // APLICANDO BÔNUS PARA KILLER MOVES
+    // Razoring
     // =============================================================
-    // Antes de ordenar, verificamos se algum lance gerado é um Killer Move desse ply.
-    // Se for, damos um score alto para ele ser testado logo após as capturas.
-    
-    
+    // O contrário: eval muito abaixo de alpha perto das folhas. Só uma captura
+    // salvaria, então a q-search decide; se ela também não chega em alpha, corta
+    if (nodePruning && params.useRazoring && depth <= params.razorMaxDepth
+        && staticEval + params.razorMargin * depth < alpha) {
+        int score = quiescence(board, alpha, beta);
+        if (stopped()) return 0;
+        if (score <= alpha) return score;
+    }
 
-    if (ply < MAX_PLY) {
-        for (auto& m : moves) {
-            // Bonus grande se o movimento veio da TT
-            if(m == ttMove) {
-                m.score = 30000;
-                continue;
-            }
-            
-            // Ignorar capturas, deixar para MVV-LVA
-            if (m.flags & CAPTURE) continue;
-            
-            // Aplicar bônus se for killer move (quiet move que fez beta cutoff)
-            else if (m.from == killerMoves[ply][0].from && m.to == killerMoves[ply][0].to) {
-                m.score = KILLER_1_SCORE;
-            }
-            else if (m.from == killerMoves[ply][1].from && m.to == killerMoves[ply][1].to) {
-                m.score = KILLER_2_SCORE;
-            }
-            else {
-                // Se não for captura nem killer, recebe a pontuação do histórico
-                int side = board.whiteToMove ? 0 : 1;
-                m.score = history[side][m.from][m.to];
-                if (m.score > 7000) 
-                    m.score = 7000;
+    // =============================================================
+    // Null Move Pruning
+    // =============================================================
+    // Se mesmo passando a vez o oponente não consegue baixar o score para
+    // menos de beta (numa busca bem mais rasa), um lance de verdade também
+    // passaria: corta sem buscar os lances. Não vale:
+    //  - em nós PV (precisamos do score exato) e em xeque (passar seria ilegal)
+    //  - logo depois de outro lance nulo (seria só a mesma posição mais rasa)
+    //  - só com rei e peões: zugzwang é comum e passar a vez pode ser o melhor "lance"
+    //  - dentro de uma busca de verificação, acima de nmpMinPly
+    if (nodePruning && allowNull && params.useNullMove && depth >= params.nullMinDepth && ply >= nmpMinPly
+        && board.byColor[side] != (board.pieces[side][PAWN] | board.pieces[side][KING])) {
+
+        if (staticEval >= beta) {
+            // R adaptativo: reduz mais em profundidades altas e quanto mais o eval passa de beta
+            int R = params.nullBaseReduction + depth / params.nullDepthDivisor
+                  + std::min((staticEval - beta) / params.nullEvalDivisor, 3);
+
+            StateInfo st;
+            board.makeNullMove(st);
+            int nullScore = -negamax<NODE_NON_PV>(board, depth - 1 - R, -beta, -beta + 1, ply + 1, false);
+            board.unmakeNullMove(st);
+
+            if (stopped()) return 0;
+
+            if (nullScore >= beta) {
+                // Mate depois de um passe não é prova de mate
+                if (nullScore >= MATE_SCORE - MAX_PLY) nullScore = beta;
+
+                if (depth < params.nullVerifyDepth) return nullScore;
+
+                // Em profundidades altas um erro de zugzwang custa caro: confirma
+                // com uma busca reduzida normal, sem lance nulo nos primeiros
+                // 3/4 dos plies dela (não só neste nó)
+                int prevMinPly = nmpMinPly;
+                nmpMinPly = ply + 3 * (depth - R) / 4;
+                int verified = negamax<NODE_NON_PV>(board, depth - R, beta - 1, beta, ply, false);
+                nmpMinPly = prevMinPly;
+                if (stopped()) return 0;
+                if (verified >= beta) return nullScore;
             }
         }
     }
 
-    std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b){
-        return a.score > b.score;
-    });
-        
-    //if (ply > 0 && ply <= 2) { 
-    //    Debug::printMoveList(moves, "Sorted Moves (Ply " + std::to_string(ply) + ")");
-    //}
+    // =============================================================
+    // Move Ordering (Ordenação de Movimentos)
+    // =============================================================
+    // O MovePicker entrega os lances em estágios, gerando cada um só quando necessário:
+    //  1. Hash Move (da Transposition Table)
+    //  2. Capturas boas (MVV-LVA + SEE)
+    //  3. Killer Moves (lances que causaram beta cutoff em irmãos)
+    //  4. Quietos pela History Heuristic
+    //  5. Capturas ruins
+    // Ainda na PV da iteração anterior: o lance dela vem antes de tudo
+    bool onPrevPV = pvNode && followPV[ply] && ply < lastResult.pvLength;
+    if (onPrevPV) ttMove = lastResult.pv[ply];
+
+    MovePicker picker(board, ttMove, ply < MAX_PLY ? killerMoves[ply] : nullptr, history[side]);
 
     // =============================================================
     // Recursão e Poda Alpha-Beta
     // =============================================================
     int bestVal = -INF;
     Move bestMove = {};
-    for (const auto& move : moves) {
-        Board nextBoard = board.applyMove(move);
-        nextBoard.updateAttackBoards(); // Prepara para o próximo nível
+    int legalMoves = 0;
+
+    // Podas por lance (futility e LMP): mesmas condições das podas do nó, mas
+    // alpha também não pode ser mate (precisamos achar um lance que escape)
+    bool movePruning = !pvNode && !inCheck && std::abs(alpha) < MATE_SCORE - MAX_PLY;
+    int futilityValue = staticEval + params.futilityBase + params.futilityMargin * depth;
+    bool futile = movePruning && params.useFutility && depth <= params.futilityMaxDepth && futilityValue <= alpha;
+
+    Move move;
+    while (picker.next(move)) {
+        ++legalMoves;
+        bool quiet = !(move.flags() & (CAPTURE | PROMOTION));
+
+        // Late Move Pruning: num nó raso, depois de lmpBase + depth² lances os
+        // quietos que sobram (os piores pelo history) nem são buscados
+        if (movePruning && params.useLMP && quiet && legalMoves > 1 && depth <= params.lmpMaxDepth
+            && legalMoves > params.lmpBase + depth * depth) {
+            continue;
+        }
+
+        if constexpr (pvNode) followPV[ply + 1] = onPrevPV && move == lastResult.pv[ply];
+
+        StateInfo st;
+        board.makeMove(move, st); // Mapas de ataque são mantidos (ou invalidados) pelo próprio makeMove
+
+        // Xeque só é conferido quando alguma poda ou redução depende dele
+        bool lmrCandidate = params.useLMR && quiet && depth >= params.lmrMinDepth && legalMoves > params.lmrMinMoves;
+        bool givesCheck = ((futile && quiet) || lmrCandidate) && board.inCheck();
+
+        // Futility Pruning: nos nós de fronteira, se nem o eval mais uma margem
+        // chega em alpha, um quieto que não dá xeque não vai mudar isso
+        if (futile && quiet && !givesCheck && legalMoves > 1) {
+            board.unmakeMove(move, st);
+            bestVal = std::max(bestVal, futilityValue); // O lance pulado vale no máximo isso
+            continue;
+        }
+
+        // =============================================================
+        // Late Move Reductions
+        // =============================================================
+        // Com uma boa ordenação, quietos no fim da lista raramente são o melhor
+        // lance: são buscados mais rasos e só voltam à profundidade cheia se
+        // surpreenderem (passarem de alpha). Reduz menos o que tem mais chance
+        // de ser bom ou tático: nós PV, killers, history alta e xeques.
+        int newDepth = depth - 1;
+        int reduction = 0;
+
+        if (lmrCandidate) {
+            reduction = LMR_TABLE[std::min(depth, MAX_PLY - 1)][std::min(legalMoves, 63)];
+
+            bool killer = ply < MAX_PLY && (move == killerMoves[ply][0] || move == killerMoves[ply][1]);
+            if (pvNode) --reduction;
+            if (killer) --reduction;
+            if (inCheck || givesCheck) --reduction; // Fugindo de xeque ou dando xeque
+            reduction -= history[side][move.from][move.to] / params.lmrHistoryDivisor;
+
+            // Nunca cai direto na q-search nem estende
+            reduction = std::clamp(reduction, 0, std::max(0, newDepth - 1));
+        }
 
         // Recursão Negamax:
         // - diminuímos profundidade (depth - 1)
         // - aumentamos a distância da raiz (ply + 1)
         // - invertemos a janela alpha-beta: alpha vira -beta, beta vira -alpha
         // - invertemos o sinal do resultado (-)
-        int score = -negamax(nextBoard, depth - 1, -beta, -alpha, ply + 1);
+        int score;
+        if (legalMoves == 1) {
+            // Primeiro lance herda o tipo do nó (num nó não-PV a janela já é nula)
+            score = -negamax<NT>(board, newDepth, -beta, -alpha, ply + 1);
+        } else if (!params.usePVS) {
+            // Sem PVS (só para comparação): janela cheia, mas o filho continua
+            // não-PV, então as podas e os cortes pela TT seguem valendo
+            score = -negamax<NODE_NON_PV>(board, newDepth - reduction, -beta, -alpha, ply + 1);
+
+            if (reduction > 0 && score > alpha && !stopped())
+                score = -negamax<NODE_NON_PV>(board, newDepth, -beta, -alpha, ply + 1);
+        } else {
+            // Scout com janela nula, possivelmente reduzido
+            score = -negamax<NODE_NON_PV>(board, newDepth - reduction, -alpha - 1, -alpha, ply + 1);
+
+            // Reduzido e passou de alpha: confirma na profundidade cheia
+            if (reduction > 0 && score > alpha && !stopped())
+                score = -negamax<NODE_NON_PV>(board, newDepth, -alpha - 1, -alpha, ply + 1);
+
+            // Passou de alpha sem passar de beta num nó PV: re-busca como PV
+            if (pvNode && score > alpha && score < beta && !stopped())
+                score = -negamax<NODE_PV>(board, newDepth, -beta, -alpha, ply + 1);
+        }
+
+        board.unmakeMove(move, st);
+
+        // Busca interrompida: o score é lixo, sai sem gravar nada na TT
+        if (stopped()) return 0;
 
         if (score > bestVal) {
             bestVal = score;
             bestMove = move;
         }
 
+        if (pvNode && score > alpha) updatePV(ply, move);
+
         // Atualiza o limite inferior (Alpha)
         alpha = std::max(alpha, bestVal);
         
@@ -271,10 +672,8 @@ int Search::negamax(const Board& board, int depth, int alpha, int beta, int ply)
         if (alpha >= beta) {
             
             // Salvar killer move 
-            if (!(move.flags & CAPTURE) && ply < MAX_PLY) {
-                bool isFirst = (move.from == killerMoves[ply][0].from && move.to == killerMoves[ply][0].to);
-                
-                if (!isFirst) {
+            if (!(move.flags() & CAPTURE) && ply < MAX_PLY) {
+                if (move != killerMoves[ply][0]) {
                     // Empurra o Killer 1 para a posição 2
                     killerMoves[ply][1] = killerMoves[ply][0];
                     // Salva o novo lance como Killer 1 (Prioridade máxima)
@@ -282,8 +681,6 @@ int Search::negamax(const Board& board, int depth, int alpha, int beta, int ply)
                 }
                 
                 //Atualizar history heuristic
-                int side = board.whiteToMove ? 0 : 1;
-                
                 // Lances que cortam perto da raiz (depth alto) ganham muitos pontos.
                 // Lances nas folhas (depth 1) ganham pouco (1 ponto).
                 int bonus = depth * depth;
@@ -299,6 +696,20 @@ int Search::negamax(const Board& board, int depth, int alpha, int beta, int ply)
         }
     }
 
+    if (legalMoves == 0) {
+        // Se não há lances legais, ou é Mate ou é Afogamento (Stalemate).
+        if (inCheck) {
+            // Xeque-mate!
+            // Retornamos -MATE + ply. 
+            // Quanto menor o ply (mais perto da raiz), maior o score (menos negativo).
+            // Isso incentiva a engine a dar mate rápido e adiar levar mate.
+            return -MATE_SCORE + ply; 
+        } else {
+            // Afogamento (Empate)
+            return 0;
+        }
+    }
+
     TTFlag flag = TT_EXACT;
     // Não conseguimos melhorar o alpha original (Fail Low)
     if (bestVal <= alphaOrig) flag = TT_ALPHA;
@@ -307,13 +718,38 @@ int Search::negamax(const Board& board, int depth, int alpha, int beta, int ply)
     
     // Se não entrou nos ifs acima, é TT_EXACT (bestVal entre alphaOrig e beta)
     // Grava na tabela
-    TT.store(board.hashKey, depth, bestVal, flag, bestMove, ply);
+    owner.tt.store(board.hashKey, depth, bestVal, flag, bestMove, ply);
 
     return bestVal;
 }
 
-int Search::quiescence(const Board& board, int alpha, int beta) {
-    ++Search::stats.qnodes;
+void SearchContext::updatePV(int ply, const Move& move) {
+    pvTable[ply][ply] = move;
+    for (int i = ply + 1; i < pvLength[ply + 1]; ++i) {
+        pvTable[ply][i] = pvTable[ply + 1][i];
+    }
+    pvLength[ply] = pvLength[ply + 1];
+}
+
+bool SearchContext::isDraw(const Board& board, int ply) const {
+    if (board.halfmoveClock >= 100) {
+        // Mate no lance que completa os 50 lances ainda vale
+        return !board.inCheck() || !MoveGen::generateMoves(board).empty();
+    }
+
+    // A mesma posição só pode voltar com o mesmo lado a jogar, e no mínimo 4 plies depois.
+    // Não atravessa um lance nulo: a posição antes dele não é do mesmo jogo
+    int idx = rootIndex + ply;
+    int limit = std::min({ board.halfmoveClock, board.pliesFromNull, idx });
+    for (int back = 4; back <= limit; back += 2) {
+        if (keyStack[idx - back] == board.hashKey) return true;
+    }
+    return false;
+}
+
+int SearchContext::quiescence(Board& board, int alpha, int beta) {
+    ++searchStats.qnodes;
+    poll();
     // Avaliamos a posição atual. Se já for boa o suficiente (>= beta),
     // assumimos que não precisamos capturar nada e cortamos (Beta Cutoff).
     // Isso evita que sejamos forçados a fazer capturas ruins.
@@ -328,18 +764,20 @@ int Search::quiescence(const Board& board, int alpha, int beta) {
         alpha = stand_pat;
     }
 
-    std::vector<Move> moves = MoveGen::generateWinningMoves(board);
+    MoveList moves = MoveGen::generateWinningMoves(board);
     
     // Ordenação MVV-LVA
-    std::sort(moves.begin(), moves.end(), [](const Move& a, const Move& b){
-        return a.score > b.score;
-    });
+    moves.sort();
 
     for (const auto& move : moves) {
-        Board nextBoard = board.applyMove(move);
-        nextBoard.updateAttackBoards();
+        StateInfo st;
+        board.makeMove(move, st);
+
+        int score = -quiescence(board, -beta, -alpha);
 
-        int score = -quiescence(nextBoard, -beta, -alpha);
+        board.unmakeMove(move, st);
+
+        if (stopped()) return 0;
 
         if (score >= beta) {
             return beta;
@@ -351,3 +789,25 @@ int Search::quiescence(const Board& board, int alpha, int beta) {
 
     return alpha;
 }
+
+// ==================================================
+//  Formatação UCI
+// ==================================================
+std::string scoreToUCI(int score) {
+    if (score >= MATE_SCORE - MAX_PLY) {
+        return "mate " + std::to_string((MATE_SCORE - score + 1) / 2);
+    }
+    if (score <= -MATE_SCORE + MAX_PLY) {
+        return "mate " + std::to_string(-(MATE_SCORE + score) / 2);
+    }
+    return "cp " + std::to_string(score);
+}
+
+std::string pvToUCI(const SearchContext::Result& result) {
+    std::string pv;
+    for (int i = 0; i < result.pvLength; ++i) {
+        if (i > 0) pv += ' ';
+        pv += moveToUCI(result.pv[i]);
+    }
+    return pv;
+}
@@ -2,52 +2,214 @@
 #include "../board/board.h"
 #include "../move/movegen.h"
 #include "../move/move.h"
+#include "../tt/tt.h"
+#include "timeman.h"
 #include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 // Valores para infinito e Mate. 
-// Mate não é infinito real para podermos calcular "Mate em X lances"
+// Mate não é infinito real para podermos calcular "Mate em X lances".
+// Vem da TT, que guarda o score em 16 bits
 constexpr int INF = 1000000;
-constexpr int MATE_SCORE = 100000; 
+constexpr int MATE_SCORE = MATE_BOUND;
 
 // Definir um pouco abaixo do OFFSET já que MVV-LVA (capturas) devem ter prioridade
 constexpr int KILLER_1_SCORE = OFFSET * 0.9;
 constexpr int KILLER_2_SCORE = OFFSET * 0.8;
 constexpr int MAX_PLY = 64;
 
+// Todo mate dentro da busca (MATE_SCORE - ply) tem que cair na faixa de mate da TT
+static_assert(MATE_SCORE - MAX_PLY > MATE_IN_MAXPLY, "faixa de mate da TT");
+
 constexpr int MAX_HISTORY = 7000;
 
+// Limite de threads do Lazy SMP
+constexpr int MAX_THREADS = 256;
+
+// De quantos em quantos nós cada thread confere o relógio e o limite de nós
+constexpr int POLL_NODES = 1024;
+
+// Posições do jogo (antes da raiz) consideradas na detecção de repetições.
+// Mais de 100 meios-lances para trás a regra dos 50 lances já encerrou o jogo.
+constexpr int MAX_GAME_KEYS = 128;
+
 struct SearchStats {
     uint64_t nodes = 0;
     uint64_t qnodes = 0;
     uint64_t evaluations = 0;
+
+    // Re-buscas da janela de aspiração, por profundidade da iteração
+    uint64_t aspirationResearches[MAX_PLY] = {};
+
+    SearchStats& operator+=(const SearchStats& other) {
+        nodes += other.nodes;
+        qnodes += other.qnodes;
+        evaluations += other.evaluations;
+        for (int d = 0; d < MAX_PLY; ++d) aspirationResearches[d] += other.aspirationResearches[d];
+        return *this;
+    }
+};
+
+// Tipo de nó do PVS. Nós PV são buscados com janela aberta e estão na
+// variante principal; os demais só provam que o score fica de um lado da janela nula.
+enum NodeType { NODE_PV, NODE_NON_PV };
+
+/**
+ * @brief Parâmetros ajustáveis da busca: margens, profundidades e reduções de
+ * todas as podas num lugar só. Cada técnica pode ser desligada separadamente
+ * para testes e comparações de nós (ver bench/params).
+ */
+struct SearchParams {
+    // Janela de aspiração: começa em +-aspirationDelta em torno do score da
+    // iteração anterior e alarga a cada falha; passou de aspirationMaxDelta, janela cheia
+    bool useAspiration = true;
+    int aspirationMinDepth = 5;
+    int aspirationDelta = 25;
+    int aspirationMaxDelta = 600;
+
+    // PVS: só o primeiro lance de um nó PV usa a janela cheia, os demais uma
+    // janela nula (re-buscados se passarem de alpha). Desligado, os demais usam a
+    // janela cheia; o tipo de nó (e as podas dos nós não-PV) não muda
+    bool usePVS = true;
+
+    // Null move pruning: R = base + depth / divisor + min((eval - beta) / evalDivisor, 3).
+    // A partir de nullVerifyDepth o corte é confirmado por uma busca sem lance nulo
+    bool useNullMove = true;
+    int nullMinDepth = 3;
+    int nullBaseReduction = 3;
+    int nullDepthDivisor = 4;
+    int nullEvalDivisor = 200;
+    int nullVerifyDepth = 10;
+
+    // Late move reductions: quietos depois dos primeiros lmrMinMoves lances, a
+    // partir de lmrMinDepth. Cada lmrHistoryDivisor pontos de history reduzem 1 ply a menos
+    bool useLMR = true;
+    int lmrMinDepth = 3;
+    int lmrMinMoves = 3;
+    int lmrHistoryDivisor = 3000;
+
+    // Reverse futility: até rfpMaxDepth, corta se eval - rfpMargin * depth >= beta
+    bool useRFP = true;
+    int rfpMaxDepth = 6;
+    int rfpMargin = 80;
+
+    // Razoring: até razorMaxDepth, se eval + razorMargin * depth < alpha, decide pela q-search
+    bool useRazoring = true;
+    int razorMaxDepth = 2;
+    int razorMargin = 250;
+
+    // Futility: até futilityMaxDepth, pula quietos sem xeque se
+    // eval + futilityBase + futilityMargin * depth <= alpha
+    bool useFutility = true;
+    int futilityMaxDepth = 3;
+    int futilityBase = 100;
+    int futilityMargin = 100;
+
+    // Late move pruning: até lmpMaxDepth, pula os quietos depois de lmpBase + depth² lances
+    bool useLMP = true;
+    int lmpMaxDepth = 3;
+    int lmpBase = 3;
 };
 
-class Search {
+class Searcher;
+
+/**
+ * @brief Estado de uma thread de busca: killers, history e contadores.
+ * A TT, os limites e o sinal de parada são do Searcher dono, o resto é só desta thread.
+ */
+class SearchContext {
 public:
+    // Última iteração completa da thread
+    struct Result {
+        Move bestMove = {};
+        int score = -INF;
+        int depth = 0;
+
+        // Variante principal: pv[0] é o bestMove, seguido da resposta esperada e assim por diante
+        Move pv[MAX_PLY] = {};
+        int pvLength = 0;
+    };
+
+    SearchContext(Searcher& owner, int threadId);
+
     /**
-     * @brief Inicia a busca pelo melhor movimento a partir do estado atual.
-     * @param board O tabuleiro raiz.
-     * @param depth Profundidade da busca (ex: 4, 5, 6 plies).
-     * @return O melhor lance encontrado.
+     * @brief Iterative deepening até maxDepth. A thread 0 é a principal: é ela
+     * que confere os limites e decide quando parar. As demais são helpers do
+     * Lazy SMP que pulam algumas profundidades.
      */
-    static Move searchBestMove(const Board& board, int depth);
+    void iterativeDeepening(const Board& board, int maxDepth);
 
+    const Result& result() const { return lastResult; }
+    const SearchStats& stats() const { return searchStats; }
 
 private:
-    static inline SearchStats stats;
-    static inline Move killerMoves[MAX_PLY][2];
-    static inline int history[2][64][64];
+    Searcher& owner;
+    int threadId;
+
+    Result lastResult;
+    SearchStats searchStats;
+    Move killerMoves[MAX_PLY][2];
+    int history[2][64][64];
+
+    // Nós até a próxima consulta aos limites
+    int pollCountdown = POLL_NODES;
+
+    // Durante a verificação do null move, lance nulo só a partir deste ply
+    // (0 = liberado): a subárvore verificada não pode depender de passar a vez
+    int nmpMinPly = 0;
+
+    // Tabela triangular da PV: a linha 'ply' guarda a melhor continuação a partir
+    // daquele ply, em pvTable[ply][ply .. pvLength[ply])
+    Move pvTable[MAX_PLY + 1][MAX_PLY + 1];
+    int pvLength[MAX_PLY + 1];
+
+    // O caminho da raiz até o ply segue a PV da iteração anterior? Nesses nós o
+    // lance da PV é tentado primeiro, mesmo que a TT tenha perdido a entrada
+    bool followPV[MAX_PLY + 1];
+
+    /**
+     * @brief 'move' melhorou alpha no ply: ele mais a PV do filho viram a PV do ply
+     */
+    void updatePV(int ply, const Move& move);
+
+    // Hashes das posições do jogo antes da raiz seguidas das do caminho atual
+    // da busca: a posição no ply 'p' fica em keyStack[rootIndex + p]
+    uint64_t keyStack[MAX_GAME_KEYS + MAX_PLY + 1];
+    int rootIndex = 0;
+
+    /**
+     * @brief A posição no ply 'ply' é empate pela regra dos 50 lances ou por
+     * repetição? Só olha para trás até o último lance irreversível (halfmoveClock)
+     * ou lance nulo (pliesFromNull).
+     * Dentro da árvore uma única repetição já conta como empate.
+     */
+    bool isDraw(const Board& board, int ply) const;
+
+    // Busca interrompida (limite atingido, stop() ou fim da thread principal)
+    bool stopped() const;
+
+    // Chamado a cada nó: a cada POLL_NODES nós publica a contagem e, na thread principal, confere os limites
+    void poll();
 
     /**
-     * @brief O algoritmo Negamax com Alpha-Beta Pruning.
-     * * @param board Estado atual.
+     * @brief O algoritmo Negamax com Alpha-Beta Pruning e PVS.
+     * @tparam NT NODE_PV (janela aberta, sem cortes pela TT) ou NODE_NON_PV (janela nula)
+     * * @param board Estado atual. Os lances são aplicados in-place (make/unmake),
+     * o tabuleiro volta ao estado original ao fim da chamada.
      * @param depth Profundidade restante.
      * @param alpha O melhor score que o lado atual já garantiu (limite inferior).
      * @param beta O melhor score que o oponente já garantiu (limite superior).
      * @param ply Distância da raiz (usado para preferir mates mais rápidos).
+     * @param allowNull Falso logo depois de um lance nulo e na busca de verificação
+     * (que também proíbe o lance nulo nos plies de baixo via nmpMinPly).
      * @return A pontuação da posição (do ponto de vista de quem joga).
      */
-    static int negamax(const Board& board, int depth, int alpha, int beta, int ply);
+    template<NodeType NT>
+    int negamax(Board& board, int depth, int alpha, int beta, int ply, bool allowNull = true);
 
     /**
      * @brief Q-search, usada após a profundidade limite para continuar buscando
@@ -57,5 +219,151 @@ private:
      * @param beta  Melhor score do oponente
      * @return A pontuação da posição (do ponto de vista de quem joga).
      */
-    static int quiescence(const Board& board, int alpha, int beta);
+    int quiescence(Board& board, int alpha, int beta);
+
+    /**
+     * @brief Busca todos os lances da raiz com a janela (alpha, beta).
+     * No primeiro lance que passa de beta (fail high) para e o leva para o
+     * início da lista, para a re-busca começar por ele.
+     * @param bestMove Recebe o melhor lance (só confiável se o score > alpha)
+     * @return O melhor score (<= alpha em fail low, >= beta em fail high)
+     */
+    int searchRoot(Board& root, MoveList& moves, int depth, int alpha, int beta, Move& bestMove);
 };
+
+/**
+ * @brief Uma iteração completa da thread principal, passada ao callback de info
+ */
+struct SearchInfo {
+    const SearchContext::Result& result;
+    uint64_t nodes;     // Somados entre as threads (aproximado: publicados em lotes)
+    int64_t timeMs;     // Desde o início da busca
+    int hashfull;       // Ocupação da TT, em permil
+};
+
+/**
+ * @brief Uma busca independente: dona das suas threads (contextos) e de uma
+ * referência para a TT. Vários Searchers podem buscar ao mesmo tempo no mesmo
+ * processo, cada um com a sua TT (ou compartilhando uma, se desejado).
+ * Criar é barato e o mesmo objeto é reaproveitado de um lance para o outro.
+ */
+class Searcher {
+public:
+    explicit Searcher(TranspositionTable& tt);
+
+    Searcher(const Searcher&) = delete;
+    Searcher& operator=(const Searcher&) = delete;
+
+    /**
+     * @brief Inicia a busca pelo melhor movimento a partir do estado atual.
+     * Bloqueia até algum limite ser atingido ou stop() ser chamado.
+     * @param board O tabuleiro raiz.
+     * @param limits Profundidade, nós e/ou tempo (ver SearchLimits).
+     * @return O melhor lance da última iteração completa.
+     */
+    Move searchBestMove(const Board& board, const SearchLimits& limits);
+
+    /**
+     * @brief Busca de profundidade fixa (ex: 4, 5, 6 plies), sem limite de tempo
+     */
+    Move searchBestMove(const Board& board, int depth) {
+        return searchBestMove(board, SearchLimits::fixedDepth(depth));
+    }
+
+    /**
+     * @brief Pede para a busca em andamento parar. Pode ser chamado de outra
+     * thread; a busca termina em até POLL_NODES nós e devolve o lance da
+     * última iteração completa. Sem efeito se nenhuma busca estiver rodando.
+     */
+    void stop() { stopSearch.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Numa busca iniciada com limits.ponder, o lance esperado foi jogado:
+     * a partir de agora os limites de tempo valem (contados desde o início da busca)
+     */
+    void ponderhit() { pondering.store(false, std::memory_order_relaxed); }
+
+    /**
+     * @brief Chamado pela thread principal ao fim de cada iteração completa
+     * (ex: linhas "info" do UCI). Roda dentro da busca: deve ser rápido.
+     */
+    using InfoCallback = std::function<void(const SearchInfo&)>;
+    void setInfoCallback(InfoCallback callback) { infoCallback = std::move(callback); }
+
+    /**
+     * @brief Resultado escolhido na última busca (lance, score, profundidade e PV)
+     */
+    const SearchContext::Result& lastResult() const { return bestResult; }
+
+    /**
+     * @brief Estatísticas da última busca (nós, qnodes, avaliações), somadas entre as threads
+     */
+    const SearchStats& lastStats() const { return lastSearch; }
+
+    /**
+     * @brief Número de threads usadas pelas próximas buscas (Lazy SMP), entre 1 e MAX_THREADS
+     */
+    void setThreads(int n);
+    int threads() const { return int(contexts.size()); }
+
+    TranspositionTable& table() { return tt; }
+
+    /**
+     * @brief Parâmetros das próximas buscas (não mudar durante uma busca)
+     */
+    SearchParams& params() { return searchParams; }
+
+    /**
+     * @brief Hashes das posições do jogo antes da raiz, da mais antiga para a
+     * mais recente (sem a própria raiz). Usados pelas próximas buscas para
+     * detectar repetições; passe um vetor vazio ao mudar de jogo.
+     */
+    void setGameHistory(std::vector<uint64_t> keys) { gameKeys = std::move(keys); }
+
+private:
+    friend class SearchContext;
+
+    TranspositionTable& tt;
+    std::vector<std::unique_ptr<SearchContext>> contexts;
+    SearchStats lastSearch;
+    SearchContext::Result bestResult;
+    SearchParams searchParams;
+    std::vector<uint64_t> gameKeys;
+    InfoCallback infoCallback;
+
+    // Limites da busca em andamento
+    SearchLimits limits;
+    TimeManager timer;
+
+    // Nós buscados por todas as threads, publicados em lotes de POLL_NODES
+    std::atomic<uint64_t> nodesSearched{0};
+
+    // Ligado por stop(), por um limite atingido ou pela thread principal ao
+    // terminar: todas as threads abandonam a busca
+    std::atomic<bool> stopSearch{false};
+
+    // Busca em modo ponder: os limites de tempo só valem depois de ponderhit()
+    std::atomic<bool> pondering{false};
+
+    /**
+     * @brief Confere o limite de nós e o hard limit de tempo (só na thread principal).
+     * Em ponder o tempo não conta
+     */
+    void checkLimits();
+
+    /**
+     * @brief Votação entre as threads pelo lance final
+     */
+    const SearchContext::Result& pickBestThread() const;
+};
+
+/**
+ * @brief Score no formato do UCI: "cp 35", ou "mate 3" / "mate -2" quando há mate
+ * (em lances, negativo se quem joga leva o mate)
+ */
+std::string scoreToUCI(int score);
+
+/**
+ * @brief A PV do resultado em notação UCI, separada por espaços ("e2e4 e7e5 g1f3")
+ */
+std::string pvToUCI(const SearchContext::Result& result);
@@ -0,0 +1,53 @@
+#include "timeman.h"
+#include <algorithm>
+
+void TimeManager::init(const SearchLimits& limits, bool whiteToMove) {
+    start = std::chrono::steady_clock::now();
+    softLimit = hardLimit = 0;
+    fixedTime = false;
+
+    if (limits.infinite) return;
+
+    // Tempo fixo: usa o movetime inteiro, sem parar antes pela estabilidade
+    if (limits.movetime > 0) {
+        softLimit = hardLimit = std::max<int64_t>(1, limits.movetime - MOVE_OVERHEAD);
+        fixedTime = true;
+        return;
+    }
+
+    if (!limits.usesClock()) return;
+
+    int64_t time = std::max<int64_t>(0, whiteToMove ? limits.wtime : limits.btime);
+    int64_t inc  = std::max<int64_t>(0, whiteToMove ? limits.winc  : limits.binc);
+    int movesToGo = limits.movestogo > 0 ? std::min(limits.movestogo, 50) : DEFAULT_MOVES_TO_GO;
+
+    // Nunca conta com o tempo todo do relógio. Com o relógio zerado
+    // (controle só de incremento) o orçamento sai do incremento.
+    int64_t available = std::max<int64_t>(0, time - MOVE_OVERHEAD);
+    int64_t usableInc = std::max<int64_t>(0, inc - MOVE_OVERHEAD);
+
+    // Fatia ideal do lance: o restante dividido pelos lances que faltam, mais o incremento
+    softLimit = available / movesToGo + usableInc * 3 / 4;
+
+    // O teto permite esticar em posições instáveis, sem passar de uma fração do relógio
+    hardLimit = std::min(softLimit * 3, (available + usableInc) / 2);
+    if (movesToGo == 1) hardLimit = available + usableInc; // Último lance antes do controle
+
+    // Com o relógio quase no fim o teto pode dar 0: garante 1 ms antes do clamp (lo <= hi)
+    hardLimit = std::max<int64_t>(hardLimit, 1);
+    softLimit = std::clamp<int64_t>(softLimit, 1, hardLimit);
+}
+
+bool TimeManager::softLimitReached(int stability) const {
+    if (!enabled() || fixedTime) return false;
+
+    // Melhor lance recém-trocado ganha mais tempo, lance estável gasta menos.
+    // Escala (em %) indexada pelas iterações seguidas com o mesmo lance.
+    static constexpr int STABILITY_SCALE[] = { 160, 130, 110, 90, 80, 70 };
+    int idx = std::min<int>(stability, std::size(STABILITY_SCALE) - 1);
+
+    int64_t limit = std::min(hardLimit, softLimit * STABILITY_SCALE[idx] / 100);
+
+    // A próxima iteração custa várias vezes a anterior: se já passou da metade, nem começa
+    return elapsed() >= limit / 2;
+}
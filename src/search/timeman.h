@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <chrono>
+
+/**
+ * @brief Limites de uma busca, no mesmo formato do comando "go" do UCI.
+ * Campos zerados não limitam nada; sem nenhum limite a busca vai até 'depth'.
+ * Os relógios usam -1 para "não informado": um relógio em 0 ainda é controle de tempo.
+ */
+struct SearchLimits {
+    int depth = 0;          // Profundidade máxima (0 = até MAX_PLY)
+    uint64_t nodes = 0;     // Nós (somados entre as threads)
+    int64_t movetime = 0;   // Tempo fixo para o lance, em ms
+    int64_t wtime = -1;     // Relógio das brancas, em ms (-1 = não informado)
+    int64_t btime = -1;     // Relógio das pretas, em ms (-1 = não informado)
+    int64_t winc = 0;       // Incremento das brancas, em ms
+    int64_t binc = 0;       // Incremento das pretas, em ms
+    int movestogo = 0;      // Lances até o próximo controle (0 = morte súbita)
+    bool infinite = false;  // Só para com Searcher::stop()
+    bool ponder = false;    // Limites de tempo suspensos até Searcher::ponderhit()
+
+    static SearchLimits fixedDepth(int d) {
+        SearchLimits limits;
+        limits.depth = d;
+        return limits;
+    }
+
+    bool usesClock() const { return wtime >= 0 || btime >= 0; }
+};
+
+/**
+ * @brief Divide o tempo de um lance em dois limites:
+ *  - soft: conferido ao fim de cada iteração; não vale a pena começar outra
+ *    depois dele. É escalado pela estabilidade do melhor lance: se ele não
+ *    muda há várias iterações, para antes; se acabou de mudar, estica.
+ *  - hard: conferido durante a busca (a cada POLL_NODES nós); a busca é
+ *    interrompida e devolve o lance da última iteração completa.
+ * Com movetime os dois coincidem e só o hard vale.
+ */
+class TimeManager {
+public:
+    // Margem para a latência da GUI/rede, em ms
+    static constexpr int64_t MOVE_OVERHEAD = 30;
+
+    // Lances restantes assumidos em morte súbita
+    static constexpr int DEFAULT_MOVES_TO_GO = 30;
+
+    /**
+     * @brief Calcula os limites para o lado a jogar e zera o relógio
+     */
+    void init(const SearchLimits& limits, bool whiteToMove);
+
+    // Milissegundos desde init()
+    int64_t elapsed() const {
+        auto now = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
+    }
+
+    bool enabled() const { return hardLimit > 0; }
+
+    bool hardLimitReached() const { return enabled() && elapsed() >= hardLimit; }
+
+    /**
+     * @brief Deve parar depois da iteração que acabou de terminar?
+     * @param stability Iterações seguidas com o mesmo melhor lance
+     */
+    bool softLimitReached(int stability) const;
+
+    int64_t softMs() const { return softLimit; }
+    int64_t hardMs() const { return hardLimit; }
+
+private:
+    std::chrono::steady_clock::time_point start;
+    int64_t softLimit = 0;
+    int64_t hardLimit = 0;   // 0 = sem limite de tempo
+    bool fixedTime = false;  // movetime: só o hard limit vale
+};
@@ -1,4 +1,5 @@
 #include "tt.h"
+#include "../debuglib/debug.h"
 #include <cstring>
 #include <iostream>
 
@@ -48,7 +49,7 @@ void TranspositionTable::resize(int mbSize) {
     table.shrink_to_fit();
     clear();
 
-    std::cout << "TT: Resized to " << mbSize << "MB -> " 
+    Debug::cout << "TT: Resized to " << mbSize << "MB -> " 
               << numClusters << " clusters (Power of 2). Mask: " 
               << std::hex << (numClusters - 1) << std::dec << std::endl;
 }
@@ -70,8 +71,10 @@ bool TranspositionTable::probe(uint64_t key, TTEntry& entry, int ply) {
 
     // Varre bucket
     for (int i = 0; i < 4; i++) {
-        if (cluster.entry[i].key == key) {
-            entry = cluster.entry[i];
+        // Copia antes de conferir: outra thread pode estar escrevendo nessa entrada
+        TTEntry e = cluster.entry[i];
+        if (e.matches(key)) {
+            entry = e;
             
             // Recupera score relativo ao ply atual
             entry.score = (int16_t)scoreFromTT(entry.score, ply);
@@ -102,7 +105,7 @@ void TranspositionTable::store(uint64_t key, int depth, int score, int flag, Mov
 
     for (int i = 0; i < 4; i++) {
         // PRIORIDADE MÁXIMA: Mesma chave (Update)
-        if (cluster.entry[i].key == key) {
+        if (cluster.entry[i].matches(key)) {
             targetIdx = i;
             // Proteção simples contra overwrite fraco:
             // Só sobrescreve se novo depth for maior OU se a hash for antiga
@@ -138,13 +141,15 @@ void TranspositionTable::store(uint64_t key, int depth, int score, int flag, Mov
     }
 
     // Grava
-    TTEntry& e = cluster.entry[targetIdx];
-    e.key = key;
-    e.move = packMove(bestMove);
+    // Monta a entrada fora da tabela e grava de uma vez, com a chave já misturada aos dados
+    TTEntry e;
+    e.move = bestMove;
     e.score = (int16_t)ttScore;
     e.depth = (int8_t)depth;
     e.flag = (uint8_t)flag;
     e.generation = generation; // Carimba com a geração atual
+    e.key = key ^ e.data();
+    cluster.entry[targetIdx] = e;
 }
 
 int TranspositionTable::hashfull() const {
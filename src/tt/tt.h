@@ -1,11 +1,15 @@
 #pragma once
 #include "../move/move.h"
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
 #include <vector>
 
-// Constantes de mate para normalização
-constexpr int MATE_BOUND = 30000;      // Score base de Mate
-constexpr int MATE_IN_MAXPLY = 29000;  // Faixa onde consideramos que é mate
+// Constantes de mate para normalização. O score vai para a entrada como
+// int16_t, então o mate (e a busca, que usa o mesmo valor) tem que caber nele
+constexpr int MATE_BOUND = 32000;                 // Score base de Mate
+constexpr int MATE_IN_MAXPLY = MATE_BOUND - 1000; // Faixa onde consideramos que é mate
+static_assert(MATE_BOUND <= INT16_MAX, "TTEntry::score é int16_t");
 
 // Tipos de Score para saber se é exato ou um limite
 enum TTFlag : uint8_t {
@@ -16,17 +20,33 @@ enum TTFlag : uint8_t {
 
 // 16 bytes
 struct TTEntry {
-    uint64_t key;       // [8 bytes] Hash Check
-    PackedMove move;    // [2 bytes] Melhor lance compactado
+    uint64_t key;       // [8 bytes] Hash Check (guardado como key ^ data())
+    Move move;          // [2 bytes] Melhor lance (completo, com o tipo)
     int16_t score;      // [2 bytes] Avaliação (-32k a +32k)
     int8_t depth;       // [1 byte]  Profundidade da busca
     uint8_t flag;       // [1 byte]  Tipo de score
     uint8_t generation; // [1 byte]  Idade da entrada (0-255)
     uint8_t padding;    // Sobrou 1 byte ainda (total 16 bytes)
 
-    TTEntry() : key(0), move(0), score(0), depth(0), flag(0), padding(0) {}
+    TTEntry() : key(0), move(), score(0), depth(0), flag(0), generation(0), padding(0) {}
+
+    // Os 8 bytes depois da chave, como um inteiro
+    inline uint64_t data() const {
+        uint64_t d;
+        std::memcpy(&d, &move, sizeof(d));
+        return d;
+    }
+
+    // Lockless hashing: com várias threads escrevendo na TT ao mesmo tempo, uma
+    // entrada pode ficar com a chave de uma escrita e os dados de outra. Como a
+    // chave é guardada com XOR dos dados, essa entrada rasgada não confere (miss).
+    inline bool matches(uint64_t k) const {
+        return (key ^ data()) == k;
+    }
 };
 
+static_assert(sizeof(TTEntry) == 16 && offsetof(TTEntry, move) == 8, "TTEntry: chave + 8 bytes de dados");
+
 // 64 BYTES - 1 CACHE LINE
 struct TTCluster {
     TTEntry entry[4];
@@ -0,0 +1,109 @@
+#include "bench.h"
+#include "../tt/tt.h"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+// Não mexer na lista sem motivo: a assinatura de referência depende dela
+static const char* FENS[] = {
+    // Aberturas e meio-jogo
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "rq3rk1/ppp2ppp/1bnpb3/3N2B1/3NP3/7P/PPPQ1PP1/2KR3R w - - 7 14",
+    "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",
+    "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
+    "r1bbk1nr/pp3p1p/2n5/1N4p1/2Np1B2/8/PPP2PPP/2KR1B1R w kq - 0 13",
+    "r1bq1rk1/ppp1nppp/4n3/3p3Q/3P4/1BP1B3/PP1N2PP/R4RK1 w - - 1 16",
+    "4r1k1/r1q2ppp/ppp2n2/4P3/5Rb1/1N1BQ3/PPP3PP/R5K1 w - - 1 17",
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "r1bq1r1k/b1p1npp1/p2p3p/1p6/3PP3/1B2NN2/PP3PPP/R2Q1RK1 w - - 1 16",
+    "3r1rk1/p5pp/bpp1pp2/8/q1PP1P2/b3P3/P2NQRPP/1R2B1K1 b - - 6 22",
+    "r1q2rk1/2p1bppp/2Pp4/p6b/Q1PNp3/4B3/PP1R1PPP/2K4R w - - 2 18",
+    "4k2r/1pb2ppp/1p2p3/1R1p4/3P4/2r1PN2/P4PPP/1R4K1 b - - 3 22",
+    "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",
+    "6k1/3b3r/1p1p4/p1n2p2/1PPNpP1q/P3Q1p1/1R1RB1P1/5K2 b - - 0 1",
+    "r2r1n2/pp2bk2/2p1p2p/3q4/3PN1QP/2P3R1/P4PP1/5RK1 w - - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "r2q1rk1/pp2bppp/2n1pn2/3p4/3P4/2NBPN2/PP3PPP/R2Q1RK1 b - - 0 10",
+    "2rq1rk1/pp1bppbp/2np1np1/8/3NP3/1BN1BP2/PPPQ2PP/2KR3R b - - 0 11",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "rnbqkb1r/pp1p1ppp/4pn2/2p5/2PP4/2N5/PP2PPPP/R1BQKBNR w KQkq - 0 4",
+    "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - - 0 23",
+    "1k1r4/pp1b1R2/3q2pp/4p3/2B5/4Q3/PPP2B2/2K5 b - - 0 1",
+    "3r1k2/4npp1/1ppr3p/p6P/P2PPPP1/1NR5/5K2/2R5 w - - 0 1",
+    "r1b2rk1/2q1b1pp/p2ppn2/1p6/3QP3/1BN1B3/PPP3PP/R4RK1 w - - 0 1",
+
+    // Finais
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 11",
+    "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/8 b - - 0 1",
+    "8/8/8/8/5kp1/P7/8/1K1N4 w - - 0 1",
+    "8/8/8/5N2/8/p7/8/2NK3k w - - 0 1",
+    "8/3k4/8/8/8/4B3/4KB2/2B5 w - - 0 1",
+    "8/8/1P6/5pr1/8/4R3/7k/2K5 w - - 0 1",
+    "8/2p4P/8/kr6/6R1/8/8/1K6 w - - 0 1",
+    "8/8/3P3k/8/1p6/8/1P6/1K3n2 b - - 0 1",
+    "8/R7/2q5/8/6k1/8/1P5p/K6R w - - 0 124",
+    "8/5pk1/6p1/3P4/1p3P2/1P4PK/8/8 w - - 0 45",
+
+    // Sem lances legais (afogamento)
+    "8/8/8/8/8/6k1/6p1/6K1 w - - 0 1",
+    "7k/7P/6K1/8/3B4/8/8/8 b - - 0 1",
+};
+
+// FNV-1a de 64 bits, um valor por vez
+static uint64_t mix(uint64_t hash, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+Bench::Result Bench::run(Searcher& searcher, int depth, std::ostream& out) {
+    Result r;
+    r.depth = depth;
+    r.threads = searcher.threads();
+    r.signature = 0xCBF29CE484222325ULL;
+
+    searcher.setGameHistory({});
+
+    for (const char* fen : FENS) {
+        Board board = Board::fromFEN(fen);
+        searcher.table().clear();
+
+        // Relógio de parede: o Debug::Stopwatch não mede nada nas builds de release
+        auto start = std::chrono::steady_clock::now();
+        Move best = searcher.searchBestMove(board, depth);
+        auto end = std::chrono::steady_clock::now();
+
+        const SearchStats& st = searcher.lastStats();
+        uint64_t nodes = st.nodes + st.qnodes;
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        r.nodes += nodes;
+        r.seconds += seconds;
+        r.signature = mix(mix(r.signature, nodes), best.raw());
+        ++r.positions;
+
+        out << "Posição " << std::setw(2) << r.positions << "/" << std::size(FENS)
+            << "  nós " << std::setw(10) << nodes
+            << "  " << std::setw(8) << std::fixed << std::setprecision(1) << seconds * 1000 << " ms"
+            << "  bestmove " << (best.raw() ? moveToUCI(best) : "0000") << "\n";
+    }
+
+    return r;
+}
+
+std::string Bench::toJSON(const Result& r) {
+    char buf[320];
+    std::snprintf(buf, sizeof(buf),
+                  "{\"depth\":%d,\"hash\":%d,\"threads\":%d,\"positions\":%d,"
+                  "\"nodes\":%llu,\"signature\":\"%016llx\",\"time_ms\":%.1f,\"nps\":%llu}",
+                  r.depth, r.hashMb, r.threads, r.positions,
+                  (unsigned long long)r.nodes, (unsigned long long)r.signature,
+                  r.seconds * 1000, (unsigned long long)r.nps());
+    return buf;
+}
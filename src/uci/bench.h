@@ -0,0 +1,43 @@
+#pragma once
+#include "../search/search.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Benchmark padrão: busca de profundidade fixa num conjunto fixo de
+ * posições (aberturas, meio-jogo, finais e alguns casos sem lances legais).
+ * Com 1 thread a contagem de nós é determinística: a assinatura muda só se o
+ * comportamento da busca mudar, e o NPS mede a velocidade.
+ * Uso: "bench [depth] [hash] [threads]" no UCI ou "capy_uci bench ..." (make bench).
+ */
+namespace Bench {
+    constexpr int DEFAULT_DEPTH = 10;
+    constexpr int DEFAULT_HASH_MB = 16;
+    constexpr int DEFAULT_THREADS = 1;
+
+    struct Result {
+        int depth = 0;
+        int hashMb = 0;
+        int threads = 0;
+        int positions = 0;
+        uint64_t nodes = 0;
+        uint64_t signature = 0;   // Hash dos nós e do melhor lance de cada posição
+        double seconds = 0;       // Tempo de parede somado das buscas
+
+        uint64_t nps() const { return seconds > 0 ? uint64_t(nodes / seconds) : 0; }
+    };
+
+    /**
+     * @brief Busca todas as posições até 'depth' com a TT limpa antes de cada
+     * uma e sem histórico de jogo. A TT e as threads são as já configuradas no
+     * Searcher (quem chama ajusta e registra em hashMb/threads).
+     * @param out Recebe uma linha por posição (nós, tempo e melhor lance)
+     */
+    Result run(Searcher& searcher, int depth, std::ostream& out);
+
+    /**
+     * @brief O resultado numa linha de JSON, para acompanhar ao longo do tempo
+     */
+    std::string toJSON(const Result& result);
+}
@@ -0,0 +1,21 @@
+#include "uci.h"
+#include <string>
+
+// Ponto de entrada da engine sem GUI, para GUIs de xadrez e torneios via UCI.
+// Com argumentos, executa-os como um único comando e sai (ex: "capy_uci bench 10 16 1")
+int main(int argc, char* argv[]) {
+    UCIEngine engine;
+
+    if (argc > 1) {
+        std::string cmd;
+        for (int i = 1; i < argc; ++i) {
+            if (i > 1) cmd += ' ';
+            cmd += argv[i];
+        }
+        engine.execute(cmd);
+        return 0;
+    }
+
+    engine.loop();
+    return 0;
+}
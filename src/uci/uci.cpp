@@ -0,0 +1,260 @@
+#include "uci.h"
+#include "bench.h"
+#include "../move/movegen.h"
+#include "../tt/tt.h"
+#include "../zobrist/zobrist.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+static constexpr const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+UCIEngine::UCIEngine() {
+    Zobrist::init();
+    TT.resize(DEFAULT_HASH_MB);
+    board = Board::fromFEN(START_FEN);
+
+    // Uma linha "info" por iteração completa da thread principal
+    searcher.setInfoCallback([this](const SearchInfo& info) { sendInfo(info); });
+}
+
+UCIEngine::~UCIEngine() {
+    stopSearch();
+}
+
+void UCIEngine::send(const std::string& line) {
+    std::lock_guard lock(outputMutex);
+    std::cout << line << std::endl;
+}
+
+void UCIEngine::sendInfo(const SearchInfo& info) {
+    int64_t timeMs = std::max<int64_t>(info.timeMs, 1);
+
+    std::ostringstream ss;
+    ss << "info depth " << info.result.depth
+       << " score " << scoreToUCI(info.result.score)
+       << " nodes " << info.nodes
+       << " nps " << (info.nodes * 1000) / timeMs
+       << " hashfull " << info.hashfull
+       << " time " << info.timeMs
+       << " pv " << pvToUCI(info.result);
+    send(ss.str());
+}
+
+// ==================================================
+//  Loop de comandos
+// ==================================================
+void UCIEngine::loop() {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!execute(line)) break;
+    }
+}
+
+bool UCIEngine::execute(const std::string& line) {
+    std::istringstream is(line);
+    std::string cmd;
+    is >> cmd;
+
+    if (cmd == "uci")             cmdUci();
+    else if (cmd == "isready")    send("readyok");
+    else if (cmd == "setoption")  cmdSetOption(is);
+    else if (cmd == "position")   cmdPosition(is);
+    else if (cmd == "go")         cmdGo(is);
+    else if (cmd == "stop")       stopSearch();
+    else if (cmd == "ponderhit")  cmdPonderhit();
+    else if (cmd == "bench")      cmdBench(is);
+    else if (cmd == "quit")       return false;
+    else if (cmd == "ucinewgame") {
+        stopSearch();
+        TT.clear();
+    }
+    else if (!cmd.empty()) {
+        send("info string comando desconhecido: " + cmd);
+    }
+    return true;
+}
+
+void UCIEngine::cmdUci() {
+    send("id name Capy");
+    send("id author Nerver");
+    send("option name Hash type spin default " + std::to_string(DEFAULT_HASH_MB)
+         + " min 1 max " + std::to_string(MAX_HASH_MB));
+    send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+    send("option name Ponder type check default false");
+    send("uciok");
+}
+
+// setoption name <id> [value <x>]
+void UCIEngine::cmdSetOption(std::istringstream& is) {
+    std::string token, name, value;
+    is >> token; // "name"
+
+    // O nome pode ter espaços: vai até "value"
+    while (is >> token && token != "value") {
+        name += (name.empty() ? "" : " ") + token;
+    }
+    is >> value;
+
+    // Mudar a TT ou as threads no meio de uma busca não é seguro
+    stopSearch();
+
+    try {
+        if (name == "Hash") {
+            hashMb = std::clamp(std::stoi(value), 1, MAX_HASH_MB);
+            TT.resize(hashMb);
+        } else if (name == "Threads") {
+            searcher.setThreads(std::stoi(value));
+        } else if (name == "Ponder") {
+            // Só informa a GUI que o ponder é suportado; nada a configurar
+        } else {
+            send("info string opcao desconhecida: " + name);
+        }
+    } catch (const std::exception&) {
+        send("info string valor invalido para " + name + ": " + value);
+    }
+}
+
+// position startpos|fen <fen> [moves <m1> <m2> ...]
+void UCIEngine::cmdPosition(std::istringstream& is) {
+    std::string token, fen;
+    is >> token;
+
+    if (token == "startpos") {
+        fen = START_FEN;
+        is >> token; // "moves" (se houver)
+    } else if (token == "fen") {
+        while (is >> token && token != "moves") {
+            fen += (fen.empty() ? "" : " ") + token;
+        }
+    } else {
+        return;
+    }
+
+    board = Board::fromFEN(fen.c_str());
+    gameKeys.clear();
+
+    // Cada lance é procurado entre os legais pela notação UCI
+    while (is >> token) {
+        MoveList moves = MoveGen::generateMoves(board);
+        auto it = std::find_if(moves.begin(), moves.end(),
+                               [&](const Move& m) { return moveToUCI(m) == token; });
+        if (it == moves.end()) {
+            send("info string lance ilegal: " + token);
+            break;
+        }
+
+        gameKeys.push_back(board.hashKey);
+        board = board.applyMove(*it);
+    }
+}
+
+// go [depth N] [nodes N] [movetime T] [wtime T] [btime T] [winc T] [binc T]
+//    [movestogo N] [infinite] [ponder]
+void UCIEngine::cmdGo(std::istringstream& is) {
+    stopSearch();
+
+    SearchLimits limits;
+    std::string token;
+    while (is >> token) {
+        if (token == "depth")          is >> limits.depth;
+        else if (token == "nodes")     is >> limits.nodes;
+        else if (token == "movetime")  is >> limits.movetime;
+        else if (token == "wtime")     is >> limits.wtime;
+        else if (token == "btime")     is >> limits.btime;
+        else if (token == "winc")      is >> limits.winc;
+        else if (token == "binc")      is >> limits.binc;
+        else if (token == "movestogo") is >> limits.movestogo;
+        else if (token == "infinite")  limits.infinite = true;
+        else if (token == "ponder")    limits.ponder = true;
+    }
+
+    {
+        std::lock_guard lock(waitMutex);
+        stopRequested = false;
+        ponderPending = limits.ponder;
+    }
+
+    searcher.setGameHistory(gameKeys);
+    searching = true;
+
+    searchThread = std::thread([this, limits, root = board]() {
+        searcher.searchBestMove(root, limits);
+
+        // Busca infinita ou ponder que acabou sozinha (ex: profundidade máxima):
+        // o protocolo não deixa mandar o bestmove antes de "stop"/"ponderhit"
+        if (limits.infinite || limits.ponder) {
+            std::unique_lock lock(waitMutex);
+            waitCv.wait(lock, [&] { return stopRequested || (!limits.infinite && !ponderPending); });
+        }
+
+        const SearchContext::Result& result = searcher.lastResult();
+        std::string line = "bestmove ";
+        line += result.bestMove.raw() ? moveToUCI(result.bestMove) : "0000";
+        if (result.pvLength > 1) line += " ponder " + moveToUCI(result.pv[1]);
+        send(line);
+
+        searching = false;
+    });
+}
+
+void UCIEngine::cmdPonderhit() {
+    // O lance esperado foi jogado: a busca continua, agora com o relógio valendo
+    searcher.ponderhit();
+    {
+        std::lock_guard lock(waitMutex);
+        ponderPending = false;
+    }
+    waitCv.notify_all();
+}
+
+void UCIEngine::stopSearch() {
+    if (!searchThread.joinable()) return;
+
+    {
+        std::lock_guard lock(waitMutex);
+        stopRequested = true;
+    }
+    waitCv.notify_all();
+
+    // Repete o stop: um pedido que chega antes de a busca começar é
+    // apagado por ela ao iniciar
+    while (searching) {
+        searcher.stop();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    searchThread.join();
+}
+
+// bench [depth] [hash] [threads]
+void UCIEngine::cmdBench(std::istringstream& is) {
+    stopSearch();
+
+    int depth = Bench::DEFAULT_DEPTH;
+    int benchHash = Bench::DEFAULT_HASH_MB;
+    int benchThreads = Bench::DEFAULT_THREADS;
+    is >> depth >> benchHash >> benchThreads;
+
+    // A configuração da partida volta ao fim do bench
+    int oldThreads = searcher.threads();
+    TT.resize(std::clamp(benchHash, 1, MAX_HASH_MB));
+    searcher.setThreads(benchThreads);
+    searcher.setInfoCallback(nullptr);
+
+    Bench::Result result = Bench::run(searcher, std::clamp(depth, 1, MAX_PLY - 1), std::cout);
+    result.hashMb = std::clamp(benchHash, 1, MAX_HASH_MB);
+
+    std::ostringstream ss;
+    ss << "\n===========================\n"
+       << "Tempo total (ms): " << uint64_t(result.seconds * 1000) << "\n"
+       << "Nós buscados    : " << result.nodes << "\n"
+       << "Nós/segundo     : " << result.nps() << "\n"
+       << "Assinatura      : " << std::hex << std::setw(16) << std::setfill('0') << result.signature << std::dec << "\n"
+       << Bench::toJSON(result);
+    send(ss.str());
+
+    TT.resize(hashMb);
+    searcher.setThreads(oldThreads);
+    searcher.setInfoCallback([this](const SearchInfo& info) { sendInfo(info); });
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "../board/board.h"
+#include "../search/search.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Front-end UCI: lê comandos da entrada padrão e responde na saída padrão.
+ * Roda sem GUI (binário capy_uci, ver "make uci").
+ * A busca roda numa thread própria, então "stop", "ponderhit" e "isready" são
+ * atendidos enquanto ela pensa.
+ */
+class UCIEngine {
+public:
+    UCIEngine();
+    ~UCIEngine();
+
+    UCIEngine(const UCIEngine&) = delete;
+    UCIEngine& operator=(const UCIEngine&) = delete;
+
+    /**
+     * @brief Processa comandos até "quit" ou o fim da entrada
+     */
+    void loop();
+
+    /**
+     * @brief Executa um comando (uma linha do protocolo)
+     * @return false se o comando foi "quit"
+     */
+    bool execute(const std::string& line);
+
+private:
+    static constexpr int DEFAULT_HASH_MB = 64;
+    static constexpr int MAX_HASH_MB = 4096;
+
+    Searcher searcher{TT};
+    int hashMb = DEFAULT_HASH_MB;
+
+    // Posição do último "position" e os hashes das posições anteriores (para repetições)
+    Board board;
+    std::vector<uint64_t> gameKeys;
+
+    // Thread da busca em andamento ("go" até o "bestmove")
+    std::thread searchThread;
+    std::atomic<bool> searching = false;
+
+    // Em "go infinite" e "go ponder" o bestmove só pode sair depois de
+    // "stop" ou "ponderhit": a thread da busca espera aqui se terminar antes
+    std::mutex waitMutex;
+    std::condition_variable waitCv;
+    bool stopRequested = false;
+    bool ponderPending = false;
+
+    // Linhas da thread da busca e da thread de comandos não podem se misturar
+    std::mutex outputMutex;
+    void send(const std::string& line);
+
+    // Comandos
+    void cmdUci();
+    void cmdSetOption(std::istringstream& is);
+    void cmdPosition(std::istringstream& is);
+    void cmdGo(std::istringstream& is);
+    void cmdPonderhit();
+    void cmdBench(std::istringstream& is);
+
+    // Linha "info" de uma iteração completa (callback da busca)
+    void sendInfo(const SearchInfo& info);
+
+    /**
+     * @brief Para a busca em andamento (se houver) e espera o bestmove
+     */
+    void stopSearch();
+};